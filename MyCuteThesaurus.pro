@@ -4,63 +4,28 @@
 #
 #-------------------------------------------------
 
-QT       += core gui sql
-
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
-TARGET = MyCuteThesaurus
-TEMPLATE = app
-
-DEFINES += GIT_VERSION="\\\"$(shell git -C \""$$_PRO_FILE_PWD_"\" describe --always --tags --long)\\\""
-
-
-# DEFINES += QT_NO_DEBUG_OUTPUT
-
-# The following define makes your compiler emit warnings if you use
-# any feature of Qt which has been marked as deprecated (the exact warnings
-# depend on your compiler). Please consult the documentation of the
-# deprecated API in order to know how to port your code away from it.
-DEFINES += QT_DEPRECATED_WARNINGS
-
-# You can also make your code fail to compile if you use deprecated APIs.
-# In order to do so, uncomment the following line.
-# You can also select to disable deprecated APIs only up to a certain version of Qt.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-CONFIG += c++11
-
-SOURCES += \
-        main.cpp \
-        mainwindow.cpp \
-    db_manager.cpp \
-    log.cpp \
-    customaboutdialog.cpp \
-    mytextedit.cpp \
-    translationdialog.cpp \
-    word.cpp \
-    settingdialog.cpp
-
-HEADERS += \
-        mainwindow.h \
-    db_manager.h \
-    log.h \
-    customaboutdialog.h \
-    mytextedit.h \
-    translationdialog.h \
-    word.h \
-    settingdialog.h
-
-FORMS += \
-        mainwindow.ui \
-    translationdialog.ui \
-    settingdialog.ui
-
-INCLUDEPATH += spdlog
-
-# Default rules for deployment.
-qnx: target.path = /tmp/$${TARGET}/bin
-else: unix:!android: target.path = /opt/$${TARGET}/bin
-!isEmpty(target.path): INSTALLS += target
-
-RESOURCES += \
-    images.qrc
+# core - analysis library without any widget (static)
+# app  - the MyCuteThesaurus application, links core
+# benchmarks - QtTest benchmarks of the analysis pipeline, links core
+# tests - QtTest unit tests of the analysis core, links core
+# allocationtests - counts the heap allocations of an analysis, links core
+# generator - synthetic dictionaries and texts for load tests, links core
+
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    core \
+    app \
+    benchmarks \
+    tests \
+    allocationtests \
+    generator
+
+# replaces malloc(), so it can't share an executable with the other tests
+allocationtests.subdir = tests/allocations
+
+app.depends = core
+benchmarks.depends = core
+tests.depends = core
+allocationtests.depends = core
+generator.depends = core
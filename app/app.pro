@@ -0,0 +1,62 @@
+#-------------------------------------------------
+#
+# Project created by QtCreator 2019-03-09T19:50:40
+#
+#-------------------------------------------------
+
+QT       += core gui sql concurrent
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = MyCuteThesaurus
+TEMPLATE = app
+
+DEFINES += GIT_VERSION="\\\"$(shell git -C \""$$_PRO_FILE_PWD_"\" describe --always --tags --long)\\\""
+
+
+# DEFINES += QT_NO_DEBUG_OUTPUT
+
+# The following define makes your compiler emit warnings if you use
+# any feature of Qt which has been marked as deprecated (the exact warnings
+# depend on your compiler). Please consult the documentation of the
+# deprecated API in order to know how to port your code away from it.
+DEFINES += QT_DEPRECATED_WARNINGS
+
+# You can also make your code fail to compile if you use deprecated APIs.
+# In order to do so, uncomment the following line.
+# You can also select to disable deprecated APIs only up to a certain version of Qt.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+CONFIG += c++11
+
+include(../core/core.pri)
+
+SOURCES += \
+        main.cpp \
+        mainwindow.cpp \
+    customaboutdialog.cpp \
+    mytextedit.cpp \
+    translationdialog.cpp \
+    settingdialog.cpp \
+    virtualtextview.cpp
+
+HEADERS += \
+        mainwindow.h \
+    customaboutdialog.h \
+    mytextedit.h \
+    translationdialog.h \
+    settingdialog.h \
+    virtualtextview.h
+
+FORMS += \
+        mainwindow.ui \
+    translationdialog.ui \
+    settingdialog.ui
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
+
+RESOURCES += \
+    images.qrc
@@ -0,0 +1,68 @@
+#include "mainwindow.h"
+#include <QApplication>
+#include <QCoreApplication>
+#include <QDir>
+#include <QThreadPool>
+
+#include "batchanalysis.h"
+#include "log.h"
+
+namespace
+{
+    void initLogging( const LogOptions &options )
+    {
+        // if logs dir not exists, create dir
+        QString logDirStr{ QCoreApplication::applicationDirPath() + "/logs" };
+
+        QDir logDir;
+        if( !logDir.exists( logDirStr ) )
+        {
+            logDir.mkdir( logDirStr );
+        }
+        // ---
+
+        QString logPath{ logDirStr + "/log.txt" };
+
+        ::init_log( logPath.toStdString().c_str(), options );
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // headless mode, no widgets are created
+    if( BatchAnalysis::isRequested( argc, argv ) )
+    {
+        QCoreApplication a(argc, argv);
+
+        // stdout and stderr belong to the report
+        LogOptions logOptions{ ::defaultLogOptions() };
+        logOptions.echoToDebugOutput = false;
+        initLogging( logOptions );
+
+        const int exitCode = BatchAnalysis::run( a.arguments() );
+        ::shutdown_log();
+
+        return exitCode;
+    }
+
+    QApplication a(argc, argv);
+
+    initLogging( ::defaultLogOptions() );
+
+    int exitCode;
+
+    {
+        MainWindow w;
+        w.show();
+
+        exitCode = a.exec();
+    }
+
+    // the window waited for its analysis and export on destruction, the jobs may log until then
+    QThreadPool::globalInstance()->waitForDone();
+
+    // write everything still queued by the asynchronous logger
+    ::shutdown_log();
+
+    return exitCode;
+}
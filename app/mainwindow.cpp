@@ -0,0 +1,1259 @@
+#include "mainwindow.h"
+#include "ui_mainwindow.h"
+
+#include <QDebug>
+#include <QApplication>
+#include <QFileDialog>
+#include <QMap>
+#include <QMessageBox>
+#include <QFont>
+#include <QFontMetrics>
+#include <QTextBlock>
+#include <QTextCursor>
+#include <QTextDocument>
+#include <QTextDocumentFragment>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+#include "analysejob.h"
+#include "mytextedit.h"
+#include "customaboutdialog.h"
+#include "log.h"
+#include "translationdialog.h"
+#include "settingdialog.h"
+#include "virtualtextview.h"
+
+namespace
+{
+    // texts with more characters are shown by the virtual view instead of a QTextDocument
+    const int virtualViewThreshold{ 1 << 20 };
+
+    const QString dbName{ "mycutethesaurus.db" };
+
+    // edits arriving in quick succession only regenerate the dictionary file once
+    const int dictionaryFileDelay{ 5000 };
+}
+
+QString MainWindow::normalizeVersion( const QString &version )
+{
+    return version.mid( 0, version.lastIndexOf( '-' ) );
+}
+
+QString MainWindow::revision( const QString &version )
+{
+    return version.mid( version.lastIndexOf( '-' ) + 1 );
+}
+
+MainWindow::MainWindow( QWidget *parent )
+: QMainWindow{ parent }
+, ui{ new Ui::MainWindow }
+, renderedDocument{ nullptr }
+, virtualTextView{ nullptr }
+, dbManager{ nullptr }
+, analysed{ false }
+, knownWords{ 0 }
+, unknownWords{ 0 }
+, fileChangeWatcher{ new QFileSystemWatcher( QApplication::instance() ) }
+, openFileChangedFromExtern{ false }
+, mode{ Mode::EDIT_MODE }
+, textColors{ { TextTypeColor::FOREIGN_TEXT_KNOWN_COLOR, "#32ab32" },
+              { TextTypeColor::FOREIGN_TEXT_UNKNOWN_COLOR, "#ff0000" },
+              { TextTypeColor::NATIVE_UNMARKED_TEXT_COLOR, "#010101" },
+              { TextTypeColor::NATIVE_MARKED_TEXT_COLOR, "#A0A0A0" },
+              { TextTypeColor::STATISTIC_KNOWN_WORDS_COLOR, "#32ab32" },
+              { TextTypeColor::STATISTIC_UNKNOWN_WORDS_COLOR, "#ff0000" },
+              { TextTypeColor::HORIZONTAL_LINE_COLOR, "#bcbcbc" },
+              { TextTypeColor::SEPERATOR_COLOR, "#999999" } }
+, cacheGeneration{ -1 }
+, indexedForeignLangId{ 0 }
+, indexedNativeLangId{ 0 }
+, analyseJob{ nullptr }
+, pendingScrollPosition{ -1 }
+{
+    this->ui->setupUi( this );
+
+    this->dbManager = new DB_Manager{ this, dbName };
+
+    QObject::connect( this->ui->textEdit, &MyTextEdit::doubleClicked,
+                      this, &MainWindow::onDoubleClicked,
+                      Qt::UniqueConnection );
+
+    // takes the place of textEdit for large texts
+    this->virtualTextView = new VirtualTextView{ this, this->textColors };
+    this->virtualTextView->setFont( this->ui->textEdit->font() );
+    this->virtualTextView->hide();
+    this->ui->verticalLayout_2->insertWidget( this->ui->verticalLayout_2->indexOf( this->ui->textEdit ) + 1,
+                                              this->virtualTextView );
+
+    QObject::connect( this->virtualTextView, &VirtualTextView::doubleClicked,
+                      this, &MainWindow::onVirtualViewDoubleClicked,
+                      Qt::UniqueConnection );
+
+    this->fillComboBox();
+
+    // Set Checkbox-Lang in Control-Panel to ForeignLang set in Settings ---
+    const QString currentForeignLang{ this->dbManager->getCurrentForeignLang() };
+    this->ui->comboBox_langs->setCurrentText( currentForeignLang.toUpper() );
+    // ---
+
+    QObject::connect( this->fileChangeWatcher, &QFileSystemWatcher::fileChanged,
+                      this, &MainWindow::onOpenFileChanged,
+                      Qt::UniqueConnection );
+
+    QObject::connect( this->ui->textEdit, &MyTextEdit::escapeTriggered,
+                      this, &MainWindow::onEscape,
+                      Qt::UniqueConnection );
+
+    this->chachedTranslations.setMemoryBudget(
+        this->dbManager->getSetting( "TranslationCacheKiB", TranslationCache::defaultMemoryBudget / 1024 ) * 1024 );
+
+    this->dictionaryFileTimer.setSingleShot( true );
+    this->dictionaryFileTimer.setInterval( dictionaryFileDelay );
+
+    QObject::connect( &this->dictionaryFileTimer, &QTimer::timeout,
+                      this, &MainWindow::updateDictionaryFile,
+                      Qt::UniqueConnection );
+
+    QObject::connect( &this->dictionaryFileExport, &QFutureWatcher<QString>::finished,
+                      this, &MainWindow::onDictionaryFileExported,
+                      Qt::UniqueConnection );
+
+    this->ui->statusBar->showMessage( "Current native language: " + this->dbManager->getCurrentNativeLang() );
+}
+
+MainWindow::~MainWindow()
+{
+    this->cancelAnalyse();
+    this->saveTranslationCache();
+
+    // a pending update is left to the next analysis, it exports outdated files itself
+    this->dictionaryFileExport.waitForFinished();
+
+    delete ui;
+}
+
+QString MainWindow::getSelectedText() const
+{
+    return  this->ui->textEdit->textCursor().selectedText();
+}
+
+QString MainWindow::getNativeLang() const
+{
+    return this->dbManager->getCurrentNativeLang();
+}
+
+// the language of the text if one is selected, the foreign language of the settings otherwise
+QString MainWindow::getForeignLang() const
+{
+    return ( this->ui->comboBox_langs->currentIndex() > 0 ) ? this->ui->comboBox_langs->currentText()
+                                                            : this->dbManager->getCurrentForeignLang();
+}
+
+MainWindow::Mode MainWindow::getMode() const
+{
+    return this->mode;
+}
+
+void MainWindow::fillComboBox()
+{
+    const QVector<QString> langs = this->dbManager->getLanguages();
+    this->ui->comboBox_langs->addItem( "Select Language:" );
+
+    for( const QString &lang : langs )
+    {
+        this->ui->comboBox_langs->addItem( lang.toUpper() );
+    }
+}
+
+void MainWindow::onOpenFileChanged()
+{
+    this->openFileChangedFromExtern = true;
+}
+
+void MainWindow::onLangChanged()
+{
+    // a running analysis would bring back translations of the old languages
+    this->cancelAnalyse();
+    this->saveTranslationCache();
+    this->invalidateTranslations();
+}
+
+// the next session loads it once it analyses a text of the same language pair
+void MainWindow::saveTranslationCache() const
+{
+    if( this->indexedForeignLangId == 0 || this->indexedNativeLangId == 0 ||
+        this->chachedTranslations.size() == 0 )
+    {
+        return;
+    }
+
+    // called on exit as well, a failure only costs the next session a cold cache
+    try
+    {
+        // changed by someone else meanwhile, the cache may be outdated
+        if( this->cacheGeneration != this->dbManager->getDictionaryGeneration() )
+        {
+            return;
+        }
+
+        const QString fileName{ this->dbManager->getTranslationCacheFileName( this->indexedForeignLangId,
+                                                                              this->indexedNativeLangId ) };
+
+        if( !this->chachedTranslations.save( fileName, this->cacheGeneration ) )
+        {
+            ::logError( "Could not save the translation cache to " + fileName );
+        }
+    }
+    catch( const QString & )
+    {
+        // already logged by DB_Manager
+    }
+    catch( const char *error )
+    {
+        ::logError( error );
+    }
+}
+
+// forgets every translation looked up so far, the next analysis reads them from the database again
+void MainWindow::invalidateTranslations()
+{
+    this->chachedTranslations.clear();
+    this->cacheGeneration = -1;
+
+    this->dictionaryIndex.clear();
+    this->indexedForeignLangId = 0;
+    this->indexedNativeLangId = 0;
+}
+
+void MainWindow::on_actionAbout_Qt_triggered()
+{
+    QMessageBox::aboutQt( this );
+}
+
+void MainWindow::on_action_Exit_triggered()
+{
+    this->close();
+}
+
+void MainWindow::on_actionAbout_My_Cute_Thesaurus_triggered()
+{
+    QString version = QString("%1").arg(GIT_VERSION);
+
+    QMap<AboutSection,QString> contents{
+        { AboutSection::TITLE, "About My Cute Thesaurus" },
+        { AboutSection::VERSION, MainWindow::normalizeVersion(version) }, // "v0.1-beta-1" },
+        { AboutSection::REVISION, MainWindow::revision(version) },
+        { AboutSection::DATE, "24.07.2019" },
+        { AboutSection::SHORT_INFO, "A Let's Try [Qt] project created on <a href=http://twitch.tv/tutorexilius>"
+        "Twitch.tv/TutorExilius</a>." },
+        { AboutSection::DESCRIPTION, "Description here..."},
+        { AboutSection::RESOURCES, "Yon can download source code on <a href=https://github.com/tutorexilius/MyCuteThesaurus>GitHub:MyCuteThesaurus</a>" },
+        { AboutSection::LOGO, ":/tutor_exilius_logo_64x64.png" },
+        { AboutSection::AUTHOR, "Tutor Exilius" },
+        { AboutSection::LICENCE, "LGPL v3" }
+    };
+
+    CustomAboutDialog::about( this, contents );
+}
+
+void MainWindow::analyse()
+{
+    this->cancelAnalyse();
+
+    const QString text{ this->ui->textEdit->toPlainText() };
+    this->originForeignText = text;
+
+    AnalyseInput input;
+    input.dbName = dbName;
+    input.text = text;
+    input.wordSeperators = this->ui->textEdit->getWordSeperators();
+    input.foreignLangTag = this->ui->comboBox_langs->currentText();
+    input.nativeLangTag = this->getNativeLang();
+    input.font = this->ui->textEdit->font();
+    input.textColors = this->textColors;
+    input.cachedTranslations = this->chachedTranslations;
+    input.cacheGeneration = this->cacheGeneration;
+    input.dictionaryIndex = this->dictionaryIndex;
+    input.indexedForeignLangId = this->indexedForeignLangId;
+    input.indexedNativeLangId = this->indexedNativeLangId;
+    input.renderDocument = text.size() < virtualViewThreshold;
+    input.mapDictionary = true;
+    input.persistentCache = true;
+
+    this->analyseJob = new AnalyseJob{ this, input };
+
+    QObject::connect( this->analyseJob, &AnalyseJob::progressChanged,
+                      this, &MainWindow::onAnalyseProgress,
+                      Qt::UniqueConnection );
+
+    QObject::connect( this->analyseJob, &AnalyseJob::finished,
+                      this, &MainWindow::onAnalyseFinished,
+                      Qt::UniqueConnection );
+
+    this->analyseJob->start();
+}
+
+void MainWindow::cancelAnalyse()
+{
+    if( this->analyseJob != nullptr )
+    {
+        // the job deletes itself once its worker returned
+        this->analyseJob->cancel();
+        this->analyseJob = nullptr;
+        this->pendingScrollPosition = -1;
+
+        this->ui->statusBar->showMessage( "Analysis cancelled", 3000 );
+    }
+}
+
+void MainWindow::onAnalyseProgress( const QString &stage, const int percent )
+{
+    // progress of an already cancelled job may still be queued
+    if( this->sender() != this->analyseJob )
+    {
+        return;
+    }
+
+    this->ui->statusBar->showMessage( QString{ "Analysing: %1... %2%" }.arg( stage ).arg( percent ) );
+}
+
+void MainWindow::onAnalyseFinished()
+{
+    if( this->analyseJob == nullptr || this->sender() != this->analyseJob )
+    {
+        return;
+    }
+
+    AnalyseJob *job = this->analyseJob;
+    this->analyseJob = nullptr;
+    job->deleteLater();
+
+    const AnalyseResult &result = job->getResult();
+    QTextDocument *document = job->takeDocument();
+
+    if( !result.error.isEmpty() )
+    {
+        delete document;
+        this->ui->statusBar->showMessage( "Analysis failed: " + result.error );
+        this->onEscape();
+        return;
+    }
+
+    this->foreign_words = result.foreignWords;
+    this->chachedTranslations = result.cachedTranslations;
+    this->cacheGeneration = result.cacheGeneration;
+    this->dictionaryIndex = result.dictionaryIndex;
+    this->indexedForeignLangId = result.indexedForeignLangId;
+    this->indexedNativeLangId = result.indexedNativeLangId;
+    this->knownWords = result.knownWords;
+    this->unknownWords = result.unknownWords;
+
+    this->textLayout = result.layout;
+    this->analysed = true;
+
+    ::logInfo( QString{ "Translation cache: %1 words, %2 of %3 KiB, %4 hits, %5 misses (%6% hit rate)" }
+               .arg( this->chachedTranslations.size() )
+               .arg( this->chachedTranslations.getMemoryUsage() / 1024 )
+               .arg( this->chachedTranslations.getMemoryBudget() / 1024 )
+               .arg( this->chachedTranslations.getHits() )
+               .arg( this->chachedTranslations.getMisses() )
+               .arg( this->chachedTranslations.getHitRate() * 100.0, 0, 'f', 1 ) );
+
+    if( this->dictionaryIndex.isMapped() )
+    {
+        const BloomFilterStatistics filter{ this->dictionaryIndex.getFilterStatistics() };
+        const quint64 missing{ filter.rejected + filter.falsePositives };
+
+        ::logInfo( QString{ "Dictionary filter: %1 of %2 lookups skipped, "
+                            "false positive rate %3% (expected %4%)" }
+                   .arg( filter.rejected )
+                   .arg( filter.lookups )
+                   .arg( ( missing > 0 ) ? filter.falsePositives * 100.0 / missing : 0.0, 0, 'f', 2 )
+                   .arg( filter.expectedFalsePositiveRate * 100.0, 0, 'f', 2 ) );
+    }
+
+    if( document != nullptr )
+    {
+        // show the rendered document, the one of the last analysis isn't needed anymore
+        document->setParent( this->ui->textEdit );
+        this->ui->textEdit->setDocument( document );
+        delete this->renderedDocument;
+        this->renderedDocument = document;
+    }
+    else
+    {
+        // too large for a document, only the visible lines are rendered
+        this->virtualTextView->setContent( this->foreign_words, this->textLayout );
+    }
+
+    this->showVirtualView( document == nullptr );
+    this->updateStatistics();
+    this->ui->statusBar->showMessage( "Current native language: " + this->getNativeLang() );
+
+    if( this->pendingScrollPosition >= 0 )
+    {
+        if( this->isVirtualViewShown() )
+        {
+            this->virtualTextView->setScrollPosition( this->pendingScrollPosition );
+        }
+        else
+        {
+            this->ui->textEdit->setScrollPosition( this->pendingScrollPosition );
+        }
+
+        this->pendingScrollPosition = -1;
+    }
+}
+
+void MainWindow::showVirtualView( const bool show )
+{
+    this->virtualTextView->setVisible( show );
+    this->ui->textEdit->setVisible( !show );
+}
+
+bool MainWindow::isVirtualViewShown() const
+{
+    return !this->virtualTextView->isHidden();
+}
+
+void MainWindow::updateStatistics()
+{
+    // recalculate statistics
+    int sum = this->knownWords + this->unknownWords;
+
+    double knownPerc = ( sum > 0 ) ? this->knownWords * 100.0 / sum : 0.0;
+    double unknownPerc = ( sum > 0 ) ? this->unknownWords * 100.0 / sum : 0.0;
+
+    const QString statistics{
+        QString{ "%1 Words: Known %2 <span style=\"color: %3;\">(%4%)</span> "
+                 "Unknown %5 <span style=\"color: %6;\">(%7%)</span>" }
+                 .arg( sum )
+                 .arg( this->knownWords )
+                 .arg( this->textColors[TextTypeColor::FOREIGN_TEXT_KNOWN_COLOR] )
+                 .arg( knownPerc, 0, 'f', 2 )
+                 .arg( this->unknownWords )
+                 .arg( this->textColors[TextTypeColor::FOREIGN_TEXT_UNKNOWN_COLOR] )
+                 .arg( unknownPerc, 0, 'f', 2 )
+    };
+
+    this->ui->label_statistics->setText( statistics );
+}
+
+void MainWindow::switchToEditMode()
+{
+    this->ui->pushButton_edit->setEnabled( false );
+    this->ui->pushButton_analyse->setEnabled( true );
+
+    this->ui->action_Save->setEnabled( true );
+    this->ui->actionSave_As->setEnabled( true );
+    this->mode = Mode::EDIT_MODE;
+}
+
+void MainWindow::switchToTranslationMode()
+{
+    this->ui->pushButton_edit->setEnabled( true );
+    this->ui->pushButton_analyse->setEnabled( false );
+
+    this->ui->action_Save->setEnabled( false );
+    this->ui->actionSave_As->setEnabled( false );
+    this->mode = Mode::TRANSLATE_MODE;
+}
+
+void MainWindow::switchMode()
+{
+    if( this->mode == Mode::TRANSLATE_MODE ) // Switch to Edit Mode
+    {
+        this->switchToEditMode();
+    }
+    else // Switch to Translation Mode
+    {
+        this->switchToTranslationMode();
+    }
+}
+
+void MainWindow::on_pushButton_analyse_clicked()
+{
+    this->ui->textEdit->setReadOnly( true );
+    this->ui->comboBox_langs->setEnabled( false );
+    //this->ui->pushButton_analyse->setEnabled( false );
+    //this->ui->pushButton_edit->setEnabled( true );
+
+    // runs in background, see onAnalyseFinished()
+    this->analyse();
+
+    // edit mode can be entered again while the analysis runs, which cancels it
+    if( this->mode == Mode::EDIT_MODE )
+    {
+        this->switchMode();
+    }
+}
+
+QVector<QString> MainWindow::getTanslations( const QString &word,
+                                             const int foreignLangID,
+                                             const int nativeLangId,
+                                             bool useCache )
+{
+    QVector<QString> translations;
+
+    if( useCache && this->chachedTranslations.find( word, translations ) )
+    {
+        return translations;
+    }
+
+    if( foreignLangID == this->indexedForeignLangId &&
+        nativeLangId == this->indexedNativeLangId )
+    {
+        return this->dictionaryIndex.getTranslations( word );
+    }
+
+    return this->dbManager->getTanslations( word, foreignLangID, nativeLangId );
+}
+
+// -> is meant as "seperator" trim() .. remove not accepted seperators from start and end
+QString MainWindow::removeSeperators( const QString &word ) const
+{
+    if( word.isEmpty() )
+    {
+        return "";
+    }
+
+    QString newWord{ word };
+
+    for( int i = 0; i<word.size(); ++i )
+    {
+        QChar ch{ word.at(i) };
+
+        if( !ch.isLetter() && !this->ui->textEdit->isPartOfWordSeperators( ch ) )
+        {
+            newWord.remove( 0, 1 );
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    for( int i = word.size() - 1; i > 0; --i )
+    {
+        QChar ch{ word.at(i) };
+
+        if( !ch.isLetter() && !this->ui->textEdit->isPartOfWordSeperators( ch ) )
+        {
+            newWord.remove( newWord.size() - 1, 1 );
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return newWord;
+}
+
+void MainWindow::onDoubleClicked()
+{
+    if( !this->analysed )
+    {
+        return;
+    }
+
+    const QString doubleClickedWord_html = this->ui->textEdit->textCursor().selection().toHtml();
+
+    if( doubleClickedWord_html.contains(
+          QString{"<!--StartFragment--><span style=\" font-weight:600; color:%1;\">"}
+            .arg( this->textColors[TextTypeColor::NATIVE_UNMARKED_TEXT_COLOR] ) )
+        // TODO: check expected string-structure "<!--StartfRagemnt...<span ...color:..>" via REGEX
+
+
+            || doubleClickedWord_html.contains(
+          QString{"<!--StartFragment--><span style=\" color:%1;\">"}
+            .arg( this->textColors[TextTypeColor::HORIZONTAL_LINE_COLOR] ) )
+        // TODO: check expected string-structure "<!--StartfRagemnt...<span ...color:..>" via REGEX
+      )
+    {
+        return;
+    }
+
+    QString doubleClickedWord{ this->ui->textEdit->textCursor().selectedText().trimmed() };
+    doubleClickedWord = this->removeSeperators( doubleClickedWord );
+
+    if( !doubleClickedWord.isEmpty() )
+    {
+        this->openTranslationDialog( doubleClickedWord );
+    }
+}
+
+void MainWindow::onVirtualViewDoubleClicked( const QString &word )
+{
+    if( !this->analysed )
+    {
+        return;
+    }
+
+    const QString doubleClickedWord{ this->removeSeperators( word.trimmed() ) };
+
+    if( !doubleClickedWord.isEmpty() )
+    {
+        this->openTranslationDialog( doubleClickedWord );
+    }
+}
+
+void MainWindow::openTranslationDialog( const QString &foreignWord )
+{
+    const QString foreignLangTag = this->ui->comboBox_langs->currentText();
+    const QString nativeLangTag = this->getNativeLang();
+
+    TranslationDialog *translationDialog = new TranslationDialog{ this, this->dbManager };
+
+    translationDialog->setUnknownWordLabelText( foreignWord );
+    translationDialog->updateUnknownWordTitle( this->ui->comboBox_langs->currentText() );
+    translationDialog->updateTranslateToLangTitle( nativeLangTag );
+
+    const int foreignLangID = this->dbManager->getLangId( foreignLangTag.toLower() );
+    const int nativeLangID = this->dbManager->getLangId( nativeLangTag.toLower() );
+
+    translationDialog->setForeignLangId( foreignLangID );
+    translationDialog->setNativeLangId( nativeLangID );
+
+    const QVector<QString> words = this->dbManager->getTanslations( foreignWord, foreignLangID,  nativeLangID );
+
+    QVector<std::pair<QString,int>> word_pairs;
+
+    for( const QString &word : words )
+    {
+        const int wordID = this->dbManager->getWordId( word, nativeLangID );
+        word_pairs.push_back( std::make_pair(word, wordID) );
+    }
+
+    translationDialog->fillTranslationTable( word_pairs );
+
+    QObject::connect( translationDialog, &TranslationDialog::translationDeleted,
+                      this, &MainWindow::onTranslationDeleted,
+                      Qt::UniqueConnection );
+
+    QObject::connect( translationDialog, &TranslationDialog::translationAdded,
+                      this, &MainWindow::onTranslationAdded,
+                      Qt::UniqueConnection );
+
+    translationDialog->exec();
+}
+
+void MainWindow::onTranslationDeleted( QString foreignWord, QString translation )
+{
+    this->dictionaryIndex.removeTranslation( foreignWord, translation );
+    this->chachedTranslations.removeTranslation( foreignWord, translation );
+    // the cache follows the edit, it is still complete
+    this->cacheGeneration = this->dbManager->getDictionaryGeneration();
+
+    this->updateRenderedWord( foreignWord );
+    this->scheduleDictionaryFileUpdate();
+}
+
+void MainWindow::onTranslationAdded( QString foreignWord, QString translation )
+{
+    this->dictionaryIndex.addTranslation( foreignWord, translation );
+    this->chachedTranslations.addTranslation( foreignWord, translation );
+    this->cacheGeneration = this->dbManager->getDictionaryGeneration();
+
+    this->updateRenderedWord( foreignWord );
+    this->scheduleDictionaryFileUpdate();
+}
+
+// the index keeps edits in memory, the mapped file is regenerated once the edits are over
+void MainWindow::scheduleDictionaryFileUpdate()
+{
+    if( this->dictionaryIndex.isMapped() )
+    {
+        this->dictionaryFileTimer.start();
+    }
+}
+
+void MainWindow::updateDictionaryFile()
+{
+    if( this->indexedForeignLangId == 0 || this->indexedNativeLangId == 0 )
+    {
+        return;
+    }
+
+    if( this->dictionaryFileExport.isRunning() )
+    {
+        this->dictionaryFileTimer.start();
+        return;
+    }
+
+    const int foreignLangId{ this->indexedForeignLangId };
+    const int nativeLangId{ this->indexedNativeLangId };
+
+    // the export reads the whole language pair, it gets its own connection on a worker thread.
+    // The new generation is written to a file of its own, the mapped file stays untouched
+    // until onDictionaryFileExported() maps the new one
+    this->dictionaryFileExport.setFuture( QtConcurrent::run( [foreignLangId, nativeLangId]()
+    {
+        try
+        {
+            DB_Manager exportManager{ nullptr, dbName, "dictionary_file_export" };
+            const QString fileName{ exportManager.getDictionaryFileName( foreignLangId, nativeLangId ) };
+
+            exportManager.exportDictionary( fileName, foreignLangId, nativeLangId );
+
+            return fileName;
+        }
+        catch( const QString & )
+        {
+            // already logged, the next analysis exports the file again
+        }
+        catch( const char *error )
+        {
+            ::logError( error );
+        }
+
+        return QString{};
+    } ) );
+}
+
+// the exported file contains the edits the index keeps in memory, it replaces the mapped one
+void MainWindow::onDictionaryFileExported()
+{
+    const QString fileName{ this->dictionaryFileExport.result() };
+
+    // a running analysis has a copy of the index, the next export maps the file
+    if( fileName.isEmpty() || this->analyseJob != nullptr || !this->dictionaryIndex.isMapped() )
+    {
+        return;
+    }
+
+    try
+    {
+        // edited again or another language pair meanwhile
+        if( fileName != this->dbManager->getDictionaryFileName( this->indexedForeignLangId,
+                                                                this->indexedNativeLangId ) )
+        {
+            return;
+        }
+
+        if( this->dictionaryIndex.map( fileName, this->dbManager->getLangTag( this->indexedForeignLangId ),
+                                       this->dbManager->getLangTag( this->indexedNativeLangId ) ) )
+        {
+            // the old file isn't mapped anymore
+            this->dbManager->removeOutdatedDictionaryFiles( this->indexedForeignLangId,
+                                                            this->indexedNativeLangId, fileName );
+        }
+    }
+    catch( const QString & )
+    {
+        // already logged by DB_Manager, the old file stays mapped
+    }
+}
+
+void MainWindow::updateRenderedWord( const QString &foreignWord )
+{
+    const int lastScrollPosition{ this->isVirtualViewShown() ? this->virtualTextView->getScrollPosition()
+                                                             : this->ui->textEdit->getScrollPosition() };
+
+    if( this->rerenderWord( foreignWord ) )
+    {
+        if( this->isVirtualViewShown() )
+        {
+            this->virtualTextView->setScrollPosition( lastScrollPosition );
+        }
+        else
+        {
+            this->ui->textEdit->setScrollPosition( lastScrollPosition );
+        }
+
+        return;
+    }
+
+    // fall back to analysing the whole text again
+    this->reanalyse( lastScrollPosition );
+}
+
+void MainWindow::reanalyse( const int scrollPosition )
+{
+    this->resetStatistic();
+    this->ui->textEdit->setText( this->originForeignText );
+    this->on_pushButton_analyse_clicked();
+
+    this->pendingScrollPosition = scrollPosition;
+}
+
+// renders only the lines containing foreignWord again, returns false if that isn't possible
+bool MainWindow::rerenderWord( const QString &foreignWord )
+{
+    if( !this->analysed || this->analyseJob != nullptr )
+    {
+        return false;
+    }
+
+    const QVector<int> occurrences{ this->textLayout.occurrences.value( foreignWord ) };
+
+    if( occurrences.isEmpty() )
+    {
+        return true;
+    }
+
+    const QVector<QString> translations = this->getTanslations( foreignWord,
+                                                                this->indexedForeignLangId,
+                                                                this->indexedNativeLangId );
+
+    const bool wasKnown = this->foreign_words.hasTranslations( occurrences.first() );
+
+    // all occurrences share the translations of their word type
+    this->foreign_words.setTranslations( this->foreign_words.wordType( occurrences.first() ), translations );
+
+    QVector<int> lines;
+
+    for( const int token : occurrences )
+    {
+        if( lines.isEmpty() || lines.last() != this->textLayout.tokenLines.at( token ) )
+        {
+            lines.push_back( this->textLayout.tokenLines.at( token ) );
+        }
+    }
+
+    // the virtual view renders the lines itself once they are visible
+    if( this->isVirtualViewShown() )
+    {
+        this->virtualTextView->updateLines( this->foreign_words, lines );
+    }
+    else if( !this->rerenderLines( lines ) )
+    {
+        return false;
+    }
+
+    if( wasKnown != !translations.isEmpty() )
+    {
+        const int changed = wasKnown ? -occurrences.size() : occurrences.size();
+
+        this->knownWords += changed;
+        this->unknownWords -= changed;
+    }
+
+    this->updateStatistics();
+
+    return true;
+}
+
+// replaces the line pairs lines of the rendered document, returns false if a line got too wide
+bool MainWindow::rerenderLines( const QVector<int> &lines )
+{
+    // document position of the affected lines
+    QVector<int> lineStarts;
+    int position = 0;
+
+    for( int line = 0, i = 0; i < lines.size(); ++line )
+    {
+        if( line == lines.at( i ) )
+        {
+            lineStarts.push_back( position );
+            ++i;
+        }
+
+        position += this->textLayout.lineDocumentLength.at( line );
+    }
+
+    TextRenderer renderer{ this->ui->textEdit->font(), this->textColors };
+    QTextCursor cursor{ this->ui->textEdit->document() };
+    cursor.beginEditBlock();
+
+    // back to front, so the positions of the lines before stay valid
+    for( int i = lines.size() - 1; i >= 0; --i )
+    {
+        cursor.setPosition( lineStarts.at( i ) );
+        cursor.setPosition( lineStarts.at( i ) + this->textLayout.lineDocumentLength.at( lines.at( i ) ),
+                            QTextCursor::KeepAnchor );
+
+        // renderLinePair updates the line's length in textLayout, lineStarts were taken before
+        if( !renderer.renderLinePair( cursor, this->foreign_words, this->textLayout, lines.at( i ) ) )
+        {
+            cursor.endEditBlock();
+            return false;
+        }
+    }
+
+    cursor.endEditBlock();
+
+    return true;
+}
+
+void MainWindow::resetStatistic()
+{
+    this->knownWords = 0;
+    this->unknownWords = 0;
+    this->analysed = false;
+    this->ui->label_statistics->setText( "" );
+}
+
+void MainWindow::on_comboBox_langs_currentTextChanged( const QString &section )
+{
+    if( section == "Select Language:" )
+    {
+        this->ui->pushButton_analyse->setEnabled( false );
+    }
+    else
+    {
+        this->ui->pushButton_analyse->setEnabled( true );
+    }
+}
+
+void MainWindow::resetHighlighting()
+{
+    const QString unknownWordStyleText{
+        QString{"<span style=\" color:%1\">" }
+        .arg( this->textColors[TextTypeColor::FOREIGN_TEXT_UNKNOWN_COLOR] ) };
+    const QString knownWordStyleText{
+        QString{"<span style=\" color:%1\">" }
+        .arg( this->textColors[TextTypeColor::FOREIGN_TEXT_KNOWN_COLOR] ) };
+    const QString nativeWordStyleText{
+        QString{"<span style=\" color:%1\">" }
+        .arg( this->textColors[TextTypeColor::NATIVE_UNMARKED_TEXT_COLOR] ) };
+
+    QString htmlText{ this->ui->textEdit->toHtml() };
+    htmlText.replace( unknownWordStyleText, nativeWordStyleText );
+    htmlText.replace( knownWordStyleText, nativeWordStyleText );
+
+    if( this->ui->textEdit->toHtml() != htmlText )
+    {
+      QTextCursor cursor = this->ui->textEdit->textCursor();
+      const int cursorsPos =  cursor.position();
+
+      this->ui->textEdit->setHtml( htmlText );
+
+      cursor.setPosition( cursorsPos );
+      this->ui->textEdit->setTextCursor( cursor );
+    }
+
+    this->resetStatistic();
+}
+
+QString MainWindow::restoreForeignText() const
+{
+    QString foreignText;
+    foreignText.reserve( this->foreign_words.getText().size() );
+
+    for( int i = 0; i < this->foreign_words.size(); ++i )
+    {
+        foreignText.append( this->foreign_words.content( i ) );
+    }
+
+    return foreignText;
+}
+
+void MainWindow::reset()
+{
+    this->cancelAnalyse();
+    this->resetStatistic();
+    this->resetHighlighting();
+
+    this->showVirtualView( false );
+    this->virtualTextView->clear();
+
+    this->ui->textEdit->setTextColor( QColor::fromRgb( 0,0,0 ) );
+    this->ui->textEdit->setFontWeight( QFont::Weight::Normal );
+    this->ui->textEdit->setReadOnly( false );
+    this->ui->comboBox_langs->setEnabled( true );
+    this->ui->pushButton_analyse->setEnabled( true );
+    this->ui->pushButton_edit->setEnabled( false );
+}
+
+void MainWindow::saveAsFile()
+{
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Save File"),
+                                "",
+                                tr("Text File (*.txt)"));
+
+    if( !fileName.isEmpty() )
+    {
+        if( !this->fileChangeWatcher->files().isEmpty() )
+        {
+            this->fileChangeWatcher->removePath( this->openedFileName );
+        }
+
+        this->openedFileName = fileName;
+
+        this->saveTo( this->openedFileName );
+
+        this->fileChangeWatcher->addPath( this->openedFileName );
+
+        this->ui->action_Save->setEnabled( true );
+    }
+    else
+    {
+        qDebug() << "Cancelled save as...";
+    }
+}
+
+void MainWindow::loadFromFile()
+{
+    QString fileName = QFileDialog::getOpenFileName(
+        this, tr("Open Text File"), "", tr("Text File (*.txt)") );
+
+    if( fileName.isEmpty() )
+    {
+        return;
+    }
+
+    qDebug() << "Selected File: " << fileName;
+
+    QFile f( fileName );
+    f.open( QFile::ReadOnly | QFile::Text );
+
+    QTextStream fileStream( &f );
+
+    this->reset();
+
+    this->ui->textEdit->setText( fileStream.readAll() );
+
+
+    if( this->mode == Mode::TRANSLATE_MODE )
+    {
+        this->switchMode();
+    }
+
+    if( !this->fileChangeWatcher->files().isEmpty() )
+    {
+        this->fileChangeWatcher->removePath( this->openedFileName );
+    }
+
+    this->openedFileName = fileName;
+
+    this->fileChangeWatcher->addPath( this->openedFileName );
+    this->ui->action_Save->setEnabled( true );
+}
+
+void MainWindow::saveTo( const QString &fileName ) const
+{
+    QFile f( fileName );
+    f.open( QFile::WriteOnly | QFile::Truncate | QFile::Text );
+
+    QTextStream fileStream( &f );
+    const QString content = this->ui->textEdit->toPlainText();
+
+    fileStream << content ;
+
+    f.close();
+}
+
+void MainWindow::on_pushButton_edit_clicked()
+{
+    this->reset();
+
+    this->ui->textEdit->setText( this->originForeignText );
+
+    this->switchMode();
+}
+
+void MainWindow::on_action_Settings_triggered()
+{
+    SettingDialog *dialog = new SettingDialog{ this, this->dbManager };
+
+    QObject::connect( dialog, &SettingDialog::langChangedSignal,
+                      this, &MainWindow::onLangChanged,
+                      Qt::UniqueConnection );
+
+    dialog->exec();
+}
+
+void MainWindow::on_textEdit_textChanged()
+{
+}
+
+void MainWindow::on_action_Open_triggered()
+{
+    this->loadFromFile();
+}
+
+void MainWindow::on_action_Save_triggered()
+{
+    if( this->openedFileName.isEmpty() || this->mode == Mode::TRANSLATE_MODE )
+    {
+        return;
+    }
+
+    bool overrideFile = true;
+
+    if( this->openFileChangedFromExtern )
+    {
+        if( QMessageBox::No == QMessageBox( QMessageBox::Warning,
+                                            "File changed",
+                                            "Current file is changed. Override file?",
+                                            QMessageBox::No|QMessageBox::Yes).exec() )
+        {
+            overrideFile = false;
+        }
+        else
+        {
+            overrideFile = true;
+        }
+    }
+
+    if( overrideFile )
+    {
+        this->fileChangeWatcher->removePath( this->openedFileName );
+
+        this->saveTo( this->openedFileName );
+
+        this->openFileChangedFromExtern = false;
+        this->fileChangeWatcher->addPath( this->openedFileName );
+    }
+}
+
+void MainWindow::on_actionSave_As_triggered()
+{
+    this->saveAsFile();
+}
+
+void MainWindow::on_action_Import_Word_List_triggered()
+{
+    const QString fileName = QFileDialog::getOpenFileName(
+        this, tr("Import Word List"), "", tr("Word List (*.tsv *.csv *.txt)") );
+
+    if( fileName.isEmpty() )
+    {
+        return;
+    }
+
+    const QString foreignLangTag{ this->getForeignLang() };
+    const QString nativeLangTag{ this->getNativeLang() };
+
+    const int foreignLangId = this->dbManager->getLangId( foreignLangTag.toLower() );
+    const int nativeLangId = this->dbManager->getLangId( nativeLangTag.toLower() );
+
+    ImportStatistics statistics{ 0, 0, 0, 0 };
+
+    try
+    {
+        QApplication::setOverrideCursor( Qt::WaitCursor );
+        statistics = this->dbManager->importTranslations( fileName, foreignLangId, nativeLangId );
+        QApplication::restoreOverrideCursor();
+    }
+    catch( const QString &error )
+    {
+        QApplication::restoreOverrideCursor();
+        QMessageBox::warning( this, "Import failed", error );
+        return;
+    }
+    catch( const char *error )
+    {
+        QApplication::restoreOverrideCursor();
+        QMessageBox::warning( this, "Import failed", error );
+        return;
+    }
+
+    const qint64 pairsPerSecond{ statistics.pairs * 1000 / std::max<qint64>( 1, statistics.milliseconds ) };
+
+    QMessageBox::information( this, "Import finished",
+                              QString{ "Imported %1 translations %2 -> %3 in %4 ms (%5 per second).\n"
+                                       "Skipped lines: %6" }
+                              .arg( statistics.pairs )
+                              .arg( foreignLangTag.toUpper() )
+                              .arg( nativeLangTag.toUpper() )
+                              .arg( statistics.milliseconds )
+                              .arg( pairsPerSecond )
+                              .arg( statistics.skippedLines ) );
+
+    this->reloadTranslations();
+}
+
+void MainWindow::on_action_Export_Dictionary_triggered()
+{
+    const QString fileName = QFileDialog::getSaveFileName(
+        this, tr("Export Dictionary"), "", tr("Dictionary (*.mctd)") );
+
+    if( fileName.isEmpty() )
+    {
+        return;
+    }
+
+    const QString foreignLangTag{ this->getForeignLang() };
+    const QString nativeLangTag{ this->getNativeLang() };
+
+    try
+    {
+        QApplication::setOverrideCursor( Qt::WaitCursor );
+        const int words = this->dbManager->exportDictionary( fileName,
+                                                             this->dbManager->getLangId( foreignLangTag.toLower() ),
+                                                             this->dbManager->getLangId( nativeLangTag.toLower() ) );
+        QApplication::restoreOverrideCursor();
+
+        this->ui->statusBar->showMessage( QString{ "Exported %1 words %2 -> %3" }
+                                          .arg( words )
+                                          .arg( foreignLangTag.toUpper() )
+                                          .arg( nativeLangTag.toUpper() ), 5000 );
+    }
+    catch( const QString &error )
+    {
+        QApplication::restoreOverrideCursor();
+        QMessageBox::warning( this, "Export failed", error );
+    }
+    catch( const char *error )
+    {
+        QApplication::restoreOverrideCursor();
+        QMessageBox::warning( this, "Export failed", error );
+    }
+}
+
+void MainWindow::on_action_Import_Dictionary_triggered()
+{
+    const QString fileName = QFileDialog::getOpenFileName(
+        this, tr("Import Dictionary"), "", tr("Dictionary (*.mctd)") );
+
+    if( fileName.isEmpty() )
+    {
+        return;
+    }
+
+    ImportStatistics statistics{ 0, 0, 0, 0 };
+
+    try
+    {
+        QApplication::setOverrideCursor( Qt::WaitCursor );
+        statistics = this->dbManager->importDictionary( fileName );
+        QApplication::restoreOverrideCursor();
+    }
+    catch( const QString &error )
+    {
+        QApplication::restoreOverrideCursor();
+        QMessageBox::warning( this, "Import failed", error );
+        return;
+    }
+    catch( const char *error )
+    {
+        QApplication::restoreOverrideCursor();
+        QMessageBox::warning( this, "Import failed", error );
+        return;
+    }
+
+    QMessageBox::information( this, "Import finished",
+                              QString{ "Imported %1 translations of %2 words in %3 ms." }
+                              .arg( statistics.pairs )
+                              .arg( statistics.lines )
+                              .arg( statistics.milliseconds ) );
+
+    this->reloadTranslations();
+}
+
+// after translations were changed in bulk, every cached one may be outdated
+void MainWindow::reloadTranslations()
+{
+    this->invalidateTranslations();
+
+    if( this->analysed && this->mode == Mode::TRANSLATE_MODE )
+    {
+        this->reanalyse( this->isVirtualViewShown() ? this->virtualTextView->getScrollPosition()
+                                                    : this->ui->textEdit->getScrollPosition() );
+    }
+}
+
+void MainWindow::onEscape()
+{
+    if( this->mode == Mode::EDIT_MODE )
+    {
+        return;
+    }
+
+    this->reset();
+    this->switchToEditMode();
+    this->ui->textEdit->setText( this->originForeignText );
+}
@@ -1,6 +1,8 @@
 #ifndef MAINWINDOW_H
 #define MAINWINDOW_H
 
+#include <QFuture>
+#include <QFutureWatcher>
 #include <QMainWindow>
 #include <QTimer>
 #include <QTableWidgetItem>
@@ -10,10 +12,16 @@
 #include <QFileSystemWatcher>
 
 #include "db_manager.h"
-#include "word.h"
+#include "dictionaryindex.h"
+#include "textrenderer.h"
+#include "translationcache.h"
+#include "tokenstore.h"
 
 // Forward-Declarations
+class AnalyseJob;
+class QTextDocument;
 class TranslationDialog;
+class VirtualTextView;
 
 namespace Ui {
     class MainWindow;
@@ -30,17 +38,7 @@ public:
         TRANSLATE_MODE
     };
 
-    enum class TextTypeColor
-    {
-        FOREIGN_TEXT_KNOWN_COLOR,
-        FOREIGN_TEXT_UNKNOWN_COLOR,
-        STATISTIC_KNOWN_WORDS_COLOR,
-        STATISTIC_UNKNOWN_WORDS_COLOR,
-        HORIZONTAL_LINE_COLOR,
-        SEPERATOR_COLOR,
-        NATIVE_MARKED_TEXT_COLOR,
-        NATIVE_UNMARKED_TEXT_COLOR
-    };
+    using TextTypeColor = ::TextTypeColor;
 
     static QString normalizeVersion( const QString &version );
     static QString revision( const QString &version );
@@ -50,6 +48,7 @@ public:
 
     QString getSelectedText() const;
     QString getNativeLang() const;
+    QString getForeignLang() const;
     Mode getMode() const;
 
 private slots:
@@ -57,9 +56,14 @@ private slots:
     void onEscape();
     void onTranslationDeleted( QString foreignWord, QString translation );
     void onTranslationAdded( QString foreignWord, QString translation );
+    void onDictionaryFileExported();
 
     void onOpenFileChanged();
     void onDoubleClicked();
+    void onVirtualViewDoubleClicked( const QString &word );
+    void onAnalyseProgress( const QString &stage, const int percent );
+    void onAnalyseFinished();
+    void updateDictionaryFile();
 
     void on_actionAbout_Qt_triggered();
     void on_action_Exit_triggered();
@@ -80,23 +84,32 @@ private slots:
 
     void on_actionSave_As_triggered();
 
+    void on_action_Import_Word_List_triggered();
+
+    void on_action_Export_Dictionary_triggered();
+
+    void on_action_Import_Dictionary_triggered();
+
 private:
     void initialiseFileChangeWatcher();
     void fillComboBox();
-    QString colorizeWord( QString foreignWord, const bool isTranslated );
-    QString maskHtml( const QChar &ch ) const;
-    QString maskHtml( const QString &content ) const;
     void resetHighlighting();
     void resetStatistic();
-    void buildTranslationStructure( const QVector<Word> &foreign_words );
-    QString newText();
-    QString mergeLanguages( const QString &foreignText,
-                            const QString &nativeText,
-                            const int textEditViewWidth ) const;
-    QString htmlWord( QString word, const QString &styleColor = "black" ) const;
-    QString cascadeHtmlSpace( const int count ) const;
+    void updateStatistics();
+    void openTranslationDialog( const QString &foreignWord );
+    void showVirtualView( const bool show );
+    bool isVirtualViewShown() const;
+    void updateRenderedWord( const QString &foreignWord );
+    void reanalyse( const int scrollPosition );
+    void invalidateTranslations();
+    void reloadTranslations();
+    void scheduleDictionaryFileUpdate();
+    void saveTranslationCache() const;
+    bool rerenderWord( const QString &foreignWord );
+    bool rerenderLines( const QVector<int> &lines );
     QString restoreForeignText() const;
     void analyse();
+    void cancelAnalyse();
     void saveAsFile();
     void loadFromFile();
     void saveTo( const QString &fileName ) const;
@@ -107,14 +120,17 @@ private:
     QVector<QString> getTanslations( const QString &word,
                                      const int foreignLangID,
                                      const int nativeLangId,
-                                     bool useCache = true ) const;
+                                     bool useCache = true );
 
-    inline void cacheWord( const Word &word );
-    void updateCachedWord( const QString &foreignWord, const QString &translation );
     QString removeSeperators( const QString &word ) const;
 
     Ui::MainWindow *ui;
-    QVector<Word> foreign_words;
+    TokenStore foreign_words;
+    TextLayout textLayout;
+    // document of the last analysis shown by textEdit, nullptr before the first one
+    QTextDocument *renderedDocument;
+    // shows texts too large for textEdit in translation mode, hidden otherwise
+    VirtualTextView *virtualTextView;
 
     DB_Manager *dbManager;
     bool analysed;
@@ -127,10 +143,27 @@ private:
     Mode mode;
     QMap<TextTypeColor, QString> textColors;
 
-    // Word as String -> Word as Objcet (with Translations inside)
-    QMap<QString, Word> chachedTranslations;
+    // foreign word -> translations, bounded by the TranslationCacheKiB setting
+    TranslationCache chachedTranslations;
+    // dictionary generation chachedTranslations is valid for, saved along with it
+    qint64 cacheGeneration;
+
+    // in-memory snapshot of the translations of the language pair below
+    DictionaryIndex dictionaryIndex;
+    int indexedForeignLangId;
+    int indexedNativeLangId;
+
+    // regenerates the mapped dictionary file of the language pair above after edits,
+    // the result is the name of the exported file
+    QTimer dictionaryFileTimer;
+    QFutureWatcher<QString> dictionaryFileExport;
 
     QString originForeignText;
+
+    // currently running analysis, nullptr if there is none
+    AnalyseJob *analyseJob;
+    // restored once the running analysis finished, -1 keeps the current position
+    int pendingScrollPosition;
 };
 
 #endif // MAINWINDOW_H
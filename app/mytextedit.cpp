@@ -31,6 +31,11 @@ bool MyTextEdit::isPartOfWordSeperators( const QChar &ch ) const
     return this->part_of_word_sepearators.contains( ch );
 }
 
+QVector<QChar> MyTextEdit::getWordSeperators() const
+{
+    return this->part_of_word_sepearators;
+}
+
 int MyTextEdit::getScrollPosition() const
 {
     return this->verticalScrollBar()->value();
@@ -4,6 +4,8 @@
 #include <QTextEdit>
 #include <QVector>
 
+#include "textanalyser.h"
+
 // Forward-Declarations
 class MainWindow;
 
@@ -14,6 +16,7 @@ class MyTextEdit : public QTextEdit
 public:
     explicit MyTextEdit( QWidget *parent = nullptr );
     bool isPartOfWordSeperators( const QChar &ch ) const;
+    QVector<QChar> getWordSeperators() const;
     int getScrollPosition() const;
     void setScrollPosition( const int position );
 
@@ -31,8 +34,7 @@ public slots:
 
 private:
     MainWindow *mainWindow;
-    // TODO: initialise this vector from database!
-    QVector<QChar> part_of_word_sepearators{ '-', L'´', '`', L'’', '\'' };   // EXAMPLE
+    QVector<QChar> part_of_word_sepearators{ TextAnalyser::defaultWordSeperators() };
 };
 
 #endif // MYTEXTEDIT_H
@@ -7,6 +7,7 @@
 #include <QTableWidget>
 #include <QVariant>
 #include <QKeyEvent>
+#include <QSignalBlocker>
 #include <QDebug>
 
 TranslationDialog::TranslationDialog( QWidget *parent, DB_Manager *db_manager )
@@ -177,7 +178,15 @@ void TranslationDialog::onItemChanged( QTableWidgetItem *item )
     else
     {
         const int wordID = item->data( Qt::UserRole ).toInt();
-        this->db_manager->update( wordID, word );
+        const int updatedWordID = this->db_manager->update( wordID, word );
+
+        // renamed to a known word, the item stands for that word now
+        if( updatedWordID != wordID )
+        {
+            const QSignalBlocker blocker{ this->ui->tableWidget_translations };
+            item->setData( Qt::UserRole, QVariant( updatedWordID ) );
+        }
+
         emit translationDeleted( foreignWord, this->rememberedWordInSelectedItemWidget );
         emit translationAdded( foreignWord, item->text() );
     }
@@ -0,0 +1,280 @@
+#include "virtualtextview.h"
+
+#include <QColor>
+#include <QFontMetrics>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QScrollBar>
+
+#include <algorithm>
+
+namespace
+{
+    // line pairs rendered above and below the viewport, so scrolling a bit doesn't render anything
+    const int marginLines{ 4 };
+}
+
+VirtualTextView::VirtualTextView( QWidget *parent, const QMap<TextTypeColor, QString> &textColors )
+: QAbstractScrollArea{ parent }
+, textColors{ textColors }
+, renderer{ this->font(), textColors }
+, foreign_words{}
+, layout{}
+, lineTops{ 0 }
+, rowHeight{ 0 }
+, contentWidth{ 0 }
+, renderedLines{}
+{
+    this->viewport()->setBackgroundRole( QPalette::Base );
+}
+
+void VirtualTextView::setContent( const TokenStore &foreign_words, const TextLayout &layout )
+{
+    // the font may have changed since the last text
+    this->renderer = TextRenderer{ this->font(), this->textColors };
+
+    this->foreign_words = foreign_words;
+    this->layout = layout;
+    this->renderedLines.clear();
+    this->contentWidth = 0;
+
+    this->layoutLines();
+
+    this->verticalScrollBar()->setValue( 0 );
+    this->horizontalScrollBar()->setValue( 0 );
+    this->viewport()->update();
+}
+
+void VirtualTextView::clear()
+{
+    this->setContent( TokenStore{}, TextLayout{} );
+}
+
+void VirtualTextView::updateLines( const TokenStore &foreign_words, const QVector<int> &lines )
+{
+    this->foreign_words = foreign_words;
+
+    for( const int line : lines )
+    {
+        this->renderedLines.remove( line );
+    }
+
+    this->viewport()->update();
+}
+
+int VirtualTextView::getScrollPosition() const
+{
+    return this->verticalScrollBar()->value();
+}
+
+void VirtualTextView::setScrollPosition( const int position )
+{
+    this->verticalScrollBar()->setValue( position );
+}
+
+int VirtualTextView::lineAt( const int y ) const
+{
+    const int lineCount = this->lineTops.size() - 1;
+
+    if( lineCount <= 0 )
+    {
+        return -1;
+    }
+
+    const int line = static_cast<int>( std::upper_bound( this->lineTops.cbegin(), this->lineTops.cend(), y )
+                                       - this->lineTops.cbegin() ) - 1;
+
+    return qBound( 0, line, lineCount - 1 );
+}
+
+void VirtualTextView::paintEvent( QPaintEvent *event )
+{
+    Q_UNUSED( event )
+
+    const int lineCount = this->lineTops.size() - 1;
+
+    if( lineCount <= 0 )
+    {
+        return;
+    }
+
+    QPainter painter{ this->viewport() };
+
+    const int top = this->verticalScrollBar()->value();
+    const int left = this->horizontalScrollBar()->value();
+    const int viewportWidth = this->viewport()->width();
+
+    const int firstVisibleLine = this->lineAt( top );
+    const int lastVisibleLine = this->lineAt( top + this->viewport()->height() );
+    const int firstLine = std::max( 0, firstVisibleLine - marginLines );
+    const int lastLine = std::min( lineCount - 1, lastVisibleLine + marginLines );
+
+    this->dropRenderedLines( firstLine, lastLine );
+
+    const int ascent = QFontMetrics{ this->font() }.ascent();
+    const int lastContentWidth = this->contentWidth;
+
+    for( int line = firstLine; line <= lastLine; ++line )
+    {
+        // lines of the margin are only rendered in advance
+        const TextRenderer::RenderedLine &rendered = this->renderedLine( line );
+
+        if( line < firstVisibleLine || line > lastVisibleLine )
+        {
+            continue;
+        }
+
+        const int y = this->lineTops.at( line ) - top;
+
+        this->paintFragments( painter, rendered.foreignFragments, -left, y + ascent );
+        this->paintFragments( painter, rendered.nativeFragments, -left, y + this->rowHeight + ascent );
+
+        if( line < lineCount - 1 )
+        {
+            const int lineY = y + 2 * this->rowHeight + this->rowHeight / 2;
+
+            painter.setPen( QColor{ this->textColors.value( TextTypeColor::HORIZONTAL_LINE_COLOR ) } );
+            painter.drawLine( 0, lineY, viewportWidth, lineY );
+        }
+    }
+
+    if( this->contentWidth != lastContentWidth )
+    {
+        this->updateScrollBars();
+    }
+}
+
+void VirtualTextView::resizeEvent( QResizeEvent *event )
+{
+    QAbstractScrollArea::resizeEvent( event );
+
+    this->updateScrollBars();
+}
+
+void VirtualTextView::mouseDoubleClickEvent( QMouseEvent *event )
+{
+    const int x = event->pos().x() + this->horizontalScrollBar()->value();
+    const int y = event->pos().y() + this->verticalScrollBar()->value();
+    const int line = this->lineAt( y );
+
+    // only the words of the foreign line can be clicked
+    if( line < 0 || y - this->lineTops.at( line ) >= this->rowHeight )
+    {
+        return;
+    }
+
+    const TextRenderer::RenderedLine rendered{ this->renderedLine( line ) };
+
+    QString foreignLine;
+
+    for( const TextRenderer::Fragment &fragment : rendered.foreignFragments )
+    {
+        foreignLine.append( fragment.text );
+    }
+
+    const QFontMetrics fm{ this->font() };
+
+    for( int i = 0; i < rendered.wordTokens.size(); ++i )
+    {
+        const QString word{ this->foreign_words.content( rendered.wordTokens.at( i ) ).toString() };
+        const int start = fm.width( foreignLine.left( rendered.wordColumns.at( i ) ) );
+
+        if( x >= start && x < start + fm.width( word ) )
+        {
+            emit doubleClicked( word );
+            return;
+        }
+    }
+}
+
+void VirtualTextView::layoutLines()
+{
+    this->rowHeight = QFontMetrics{ this->font() }.lineSpacing();
+
+    const int lineCount = this->layout.lineFirstToken.size();
+
+    this->lineTops.resize( lineCount + 1 );
+    this->lineTops[0] = 0;
+
+    for( int line = 0; line < lineCount; ++line )
+    {
+        // foreign line, native line and the horizontal line, the last line pair has none
+        const int rows = ( line == lineCount - 1 ) ? 2 : 3;
+
+        this->lineTops[line + 1] = this->lineTops.at( line ) + rows * this->rowHeight;
+    }
+
+    this->updateScrollBars();
+}
+
+void VirtualTextView::updateScrollBars()
+{
+    const QSize viewportSize{ this->viewport()->size() };
+
+    this->verticalScrollBar()->setRange( 0, std::max( 0, this->lineTops.last() - viewportSize.height() ) );
+    this->verticalScrollBar()->setPageStep( viewportSize.height() );
+    this->verticalScrollBar()->setSingleStep( this->rowHeight );
+
+    this->horizontalScrollBar()->setRange( 0, std::max( 0, this->contentWidth - viewportSize.width() ) );
+    this->horizontalScrollBar()->setPageStep( viewportSize.width() );
+}
+
+// don't hold the returned reference across another call, inserting may rehash
+const TextRenderer::RenderedLine &VirtualTextView::renderedLine( const int line )
+{
+    auto it = this->renderedLines.find( line );
+
+    if( it == this->renderedLines.end() )
+    {
+        it = this->renderedLines.insert( line, this->renderer.renderLine( this->foreign_words, this->layout, line ) );
+
+        // the width of the whole text is only known for lines rendered so far
+        this->contentWidth = std::max( this->contentWidth, it->width );
+    }
+
+    return *it;
+}
+
+// drops rendered lines far away from the lines firstLine to lastLine
+void VirtualTextView::dropRenderedLines( const int firstLine, const int lastLine )
+{
+    for( auto it = this->renderedLines.begin(); it != this->renderedLines.end(); )
+    {
+        if( it.key() < firstLine - marginLines || it.key() > lastLine + marginLines )
+        {
+            it = this->renderedLines.erase( it );
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+// returns x behind the last fragment
+int VirtualTextView::paintFragments( QPainter &painter, const QVector<TextRenderer::Fragment> &fragments,
+                                     int x, const int baseline ) const
+{
+    for( const TextRenderer::Fragment &fragment : fragments )
+    {
+        const QTextCharFormat &format = this->renderer.getFormat( fragment.format );
+
+        QFont font{ this->font() };
+
+        if( format.hasProperty( QTextFormat::FontWeight ) )
+        {
+            font.setWeight( format.fontWeight() );
+        }
+
+        painter.setFont( font );
+        painter.setPen( format.hasProperty( QTextFormat::ForegroundBrush )
+                        ? format.foreground().color()
+                        : this->palette().color( QPalette::Text ) );
+
+        painter.drawText( x, baseline, fragment.text );
+
+        x += QFontMetrics{ font }.width( fragment.text );
+    }
+
+    return x;
+}
@@ -0,0 +1,75 @@
+#ifndef VIRTUALTEXTVIEW_H
+#define VIRTUALTEXTVIEW_H
+
+#include <QAbstractScrollArea>
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+#include "textrenderer.h"
+#include "tokenstore.h"
+
+// Forward-Declarations
+class QPainter;
+
+// Read-only view of an analysed text for texts too large for a QTextDocument.
+//
+// Only the line pairs inside the viewport (plus a margin of a few lines) are rendered,
+// they are painted directly and kept in a small cache while they stay close to the viewport.
+// The top of every line pair is kept in a prefix-sum array, so finding the line
+// at a scroll position is a binary search.
+class VirtualTextView : public QAbstractScrollArea
+{
+    Q_OBJECT
+
+public:
+    explicit VirtualTextView( QWidget *parent, const QMap<TextTypeColor, QString> &textColors );
+
+    // words and layout of an analysed text, see TextRenderer::buildLayout()
+    void setContent( const TokenStore &foreign_words, const TextLayout &layout );
+    void clear();
+
+    // renders lines again the next time they are visible
+    void updateLines( const TokenStore &foreign_words, const QVector<int> &lines );
+
+    int getScrollPosition() const;
+    void setScrollPosition( const int position );
+
+    // line pair at y in content coordinates
+    int lineAt( const int y ) const;
+
+signals:
+    void doubleClicked( const QString &word );
+
+protected:
+    void paintEvent( QPaintEvent *event ) override;
+    void resizeEvent( QResizeEvent *event ) override;
+    void mouseDoubleClickEvent( QMouseEvent *event ) override;
+
+private:
+    void layoutLines();
+    void updateScrollBars();
+    const TextRenderer::RenderedLine &renderedLine( const int line );
+    void dropRenderedLines( const int firstLine, const int lastLine );
+    int paintFragments( QPainter &painter, const QVector<TextRenderer::Fragment> &fragments,
+                        int x, const int baseline ) const;
+
+    QMap<TextTypeColor, QString> textColors;
+    TextRenderer renderer;
+
+    TokenStore foreign_words;
+    TextLayout layout;
+
+    // lineTops[line] is the top of line pair line, the last element the height of the whole text
+    QVector<int> lineTops;
+    int rowHeight;
+
+    // widest line rendered so far
+    int contentWidth;
+
+    // line -> rendered line pair, only lines close to the viewport
+    QHash<int, TextRenderer::RenderedLine> renderedLines;
+};
+
+#endif // VIRTUALTEXTVIEW_H
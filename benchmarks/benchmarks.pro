@@ -0,0 +1,29 @@
+#-------------------------------------------------
+#
+# Benchmarks of the analyse -> lookup -> render pipeline.
+# Run with "-platform offscreen" on machines without a display,
+# results are written to benchmark_results.xml
+#
+#-------------------------------------------------
+
+QT       += core gui sql concurrent testlib
+
+TARGET = benchmarks
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+# dictionaries are generated from copies of the shipped, empty database
+DEFINES += THESAURUS_TEMPLATE_DB=\\\"$$PWD/../mycutethesaurus.db\\\"
+
+CONFIG += c++11
+
+include(../core/core.pri)
+
+# helpers shared with the tests
+INCLUDEPATH += $$PWD/../tests
+
+SOURCES += \
+    pipelinebenchmark.cpp
@@ -0,0 +1,1001 @@
+#include <QGuiApplication>
+#include <QElapsedTimer>
+#include <QFont>
+#include <QMap>
+#include <QTemporaryDir>
+#include <QTextDocument>
+#include <QtTest>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "db_manager.h"
+#include "dictionaryindex.h"
+#include "log.h"
+#include "syntheticdata.h"
+#include "testfixtures.h"
+#include "textanalyser.h"
+#include "textrenderer.h"
+#include "tokenizer.h"
+#include "tokenstore.h"
+
+// Benchmarks every stage of analyse -> lookup -> render on its own,
+// on synthetic corpora and dictionaries of 1k, 100k and 1M words.
+//
+// Results are written to benchmark_results.xml (QtTest's xml format) and
+// stdout unless an output is given with -o, see "-help".
+class PipelineBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void tokenise_data();
+    void tokenise();
+
+    void tokeniseThroughput();
+
+    void getTranslations_data();
+    void getTranslations();
+
+    void getTranslationsBatch_data();
+    void getTranslationsBatch();
+
+    void loadDictionaryIndex_data();
+    void loadDictionaryIndex();
+
+    void mapDictionaryIndex_data();
+    void mapDictionaryIndex();
+
+    void mappedLookup_data();
+    void mappedLookup();
+
+    void buildTranslationStructure_data();
+    void buildTranslationStructure();
+
+    void translationCache_data();
+    void translationCache();
+
+    void tokenStoreFootprint();
+
+    void buildLayout_data();
+    void buildLayout();
+
+    void renderLines_data();
+    void renderLines();
+
+    void renderDocument_data();
+    void renderDocument();
+
+    void renderDocumentVsHtml_data();
+    void renderDocumentVsHtml();
+
+    void logCall_data();
+    void logCall();
+
+private:
+    void addCorpusRows();
+    void addDictionaryRows();
+    const QString &corpus( const int wordCount );
+    QString dictionary( const int entryCount );
+    TokenStore translatedWords( const int wordCount );
+
+    QTemporaryDir tempDir;
+    QString logFile;
+    QMap<int, QString> corpora;
+    QMap<int, QString> dictionaries;
+};
+
+namespace
+{
+    // count of different words the corpora are drawn from (Zipf distributed),
+    // a 1k dictionary knows only the most frequent ones, a 1M dictionary all
+    const int vocabularySize{ 200000 };
+
+    // language ids of the dictionaries, taken from the shipped database
+    const int foreignLangId{ 2 };
+    const int nativeLangId{ 1 };
+
+    // dictionary the render stages are using
+    const int renderDictionarySize{ 100000 };
+
+    const QVector<int> sizes{ 1000, 100000, 1000000 };
+
+    // line pairs of the document renderDocumentVsHtml() compares, the corpora break lines every 12 words
+    const int renderLineCount{ 10000 };
+    const int wordsPerLine{ 12 };
+
+    // a synthetic corpus with German letters: every 'q' becomes 'ü' and every "ss" 'ß',
+    // so most blocks of 16 units contain a non-ASCII letter like in German prose
+    QString germanText( QString text )
+    {
+        text.replace( 'q', QChar{ 0xFC } );
+        text.replace( "ss", QString{ QChar{ 0xDF } } );
+
+        return text;
+    }
+
+    QString sizeLabel( const int size )
+    {
+        if( size >= 1000000 )
+        {
+            return QString::number( size / 1000000 ) + "M";
+        }
+
+        if( size >= 1000 )
+        {
+            return QString::number( size / 1000 ) + "k";
+        }
+
+        return QString::number( size );
+    }
+
+    // 1000 words, every second one is part of a dictionary of entryCount entries
+    QVector<QString> lookupWords( const int entryCount )
+    {
+        QVector<QString> words;
+
+        for( int i = 0; i < 1000; ++i )
+        {
+            words.push_back( ( i % 2 == 0 ) ? SyntheticData::word( i * ( entryCount / 500 ) % entryCount )
+                                            : SyntheticData::word( entryCount + i ) );
+        }
+
+        return words;
+    }
+
+    // The HTML generation TextRenderer used before it wrote into a QTextDocument, kept
+    // as the baseline of renderDocumentVsHtml(): the whole text became one HTML string,
+    // which QTextEdit::setHtml() had to parse again
+    class HtmlReferenceRenderer
+    {
+    public:
+        explicit HtmlReferenceRenderer( const QMap<TextTypeColor, QString> &textColors )
+        : textColors{ textColors }
+        {
+        }
+
+        QString render( const TokenStore &foreign_words ) const
+        {
+            // first token of every line and the offset inside of it
+            QVector<int> lineFirstToken{ 0 };
+            QVector<int> lineFirstTokenOffset{ 0 };
+
+            for( int i = 0; i < foreign_words.size(); ++i )
+            {
+                if( !foreign_words.isWordType( i ) )
+                {
+                    const QStringRef content{ foreign_words.content( i ) };
+
+                    for( int newLine = content.indexOf( '\n' ); newLine >= 0; newLine = content.indexOf( '\n', newLine + 1 ) )
+                    {
+                        lineFirstToken.push_back( i );
+                        lineFirstTokenOffset.push_back( newLine + 1 );
+                    }
+                }
+            }
+
+            QVector<QPair<QString, QString>> renderedLines;
+            renderedLines.reserve( lineFirstToken.size() );
+
+            int longestLine = 0;
+
+            for( int line = 0; line < lineFirstToken.size(); ++line )
+            {
+                renderedLines.push_back( this->renderLine( foreign_words, lineFirstToken.at( line ),
+                                                           lineFirstTokenOffset.at( line ), longestLine ) );
+            }
+
+            QString text;
+
+            for( int line = 0; line < renderedLines.size(); ++line )
+            {
+                text.append( renderedLines.at( line ).first );
+                text.append( "<br>" );
+
+                // make translation bold ---
+                text.append( "<span style=\"font-weight: bold;\">" );
+                text.append( renderedLines.at( line ).second );
+                text.append( "</span>" );
+
+                if( line < renderedLines.size() - 1 )
+                {
+                    text.append( QString{ "<br><span style=\"color:%1\">%2</span><br>" }
+                                 .arg( this->textColors[TextTypeColor::HORIZONTAL_LINE_COLOR] )
+                                 .arg( QString{ longestLine, QChar{ 0x23AF } } ) );
+                }
+            }
+
+            return text;
+        }
+
+    private:
+        // foreign and native HTML of one line, longestLine grows to the longest line in characters
+        QPair<QString, QString> renderLine( const TokenStore &foreign_words, const int firstToken,
+                                            int offset, int &longestLine ) const
+        {
+            QString foreignHtml;
+            QString nativeHtml;
+            int length = 0;
+
+            for( int i = firstToken; i < foreign_words.size(); ++i, offset = 0 )
+            {
+                const QString content{ foreign_words.content( i ).toString() };
+                const int wordLength = content.size();
+
+                if( foreign_words.isWordType( i ) )
+                {
+                    const QVector<QString> translations{ foreign_words.getTranslations( i ) };
+
+                    foreignHtml.append( this->htmlWord( content, this->textColors[!translations.isEmpty()
+                        ? TextTypeColor::FOREIGN_TEXT_KNOWN_COLOR : TextTypeColor::FOREIGN_TEXT_UNKNOWN_COLOR] ) );
+
+                    int columnLength = wordLength;
+                    QString translationHtml;
+
+                    if( !translations.isEmpty() )
+                    {
+                        const QString &bestTranslation = translations.at( 0 );
+                        const int translationLength = this->maskedLength( bestTranslation );
+
+                        translationHtml = this->maskHtml( bestTranslation );
+
+                        if( translationLength < wordLength )
+                        {
+                            translationHtml.append( this->cascadeHtmlSpace( wordLength - translationLength ) );
+                        }
+                        else
+                        {
+                            foreignHtml.append( this->cascadeHtmlSpace( translationLength - wordLength ) );
+                            columnLength = translationLength;
+                        }
+                    }
+                    else
+                    {
+                        translationHtml = this->cascadeHtmlSpace( wordLength );
+                    }
+
+                    nativeHtml.append( this->htmlWord( translationHtml,
+                                                       this->textColors[TextTypeColor::NATIVE_UNMARKED_TEXT_COLOR] ) );
+                    length += columnLength;
+                }
+                else
+                {
+                    const int newLine = content.indexOf( '\n', offset );
+                    const QString part{ content.mid( offset, ( newLine < 0 ) ? -1 : newLine - offset ) };
+                    const QString htmlMaskedContent{ this->maskHtml( part ) };
+
+                    foreignHtml.append( htmlMaskedContent );
+                    nativeHtml.append( htmlMaskedContent );
+                    length += this->maskedLength( part );
+
+                    if( newLine >= 0 )
+                    {
+                        break;
+                    }
+                }
+            }
+
+            longestLine = std::max( longestLine, length );
+
+            return qMakePair( foreignHtml, nativeHtml );
+        }
+
+        QString maskHtml( const QString &content ) const
+        {
+            QString htmlMaskedString;
+
+            for( const QChar &ch : content )
+            {
+                if( ch == '\t' )
+                {
+                    htmlMaskedString.append( "&nbsp;&nbsp;&nbsp;&nbsp;" );
+                }
+                else if( ch.isSpace() )
+                {
+                    htmlMaskedString.append( "&nbsp;" );
+                }
+                else if( ch == '<' )
+                {
+                    htmlMaskedString.append( "&lt;" );
+                }
+                else if( ch == '>' )
+                {
+                    htmlMaskedString.append( "&gt;" );
+                }
+                else if( ch == '&' )
+                {
+                    htmlMaskedString.append( "&amp;" );
+                }
+                else
+                {
+                    htmlMaskedString.append( ch );
+                }
+            }
+
+            return htmlMaskedString;
+        }
+
+        // count of characters maskHtml( content ) becomes in the document
+        int maskedLength( const QString &content ) const
+        {
+            return content.size() + 3 * content.count( '\t' );
+        }
+
+        QString htmlWord( const QString &word, const QString &styleColor ) const
+        {
+            return QString{ "<span style=color:%1>%2</span>" }.arg( styleColor ).arg( word );
+        }
+
+        QString cascadeHtmlSpace( const int count ) const
+        {
+            QString text;
+
+            for( int i = 0; i < count; ++i )
+            {
+                text.append( "&nbsp;" );
+            }
+
+            return text;
+        }
+
+        QMap<TextTypeColor, QString> textColors;
+    };
+}
+
+void PipelineBenchmark::initTestCase()
+{
+    QVERIFY( this->tempDir.isValid() );
+
+    this->logFile = this->tempDir.filePath( "log.txt" );
+
+    LogOptions logOptions{ ::defaultLogOptions() };
+    logOptions.echoToDebugOutput = false;
+    ::init_log( this->logFile.toStdString().c_str(), logOptions );
+}
+
+void PipelineBenchmark::cleanupTestCase()
+{
+    ::shutdown_log();
+}
+
+void PipelineBenchmark::addCorpusRows()
+{
+    QTest::addColumn<int>( "wordCount" );
+
+    for( const int size : sizes )
+    {
+        QTest::newRow( qPrintable( sizeLabel( size ) + " words" ) ) << size;
+    }
+}
+
+void PipelineBenchmark::addDictionaryRows()
+{
+    QTest::addColumn<int>( "entryCount" );
+
+    for( const int size : sizes )
+    {
+        QTest::newRow( qPrintable( sizeLabel( size ) + " entries" ) ) << size;
+    }
+}
+
+const QString &PipelineBenchmark::corpus( const int wordCount )
+{
+    auto text = this->corpora.find( wordCount );
+
+    if( text == this->corpora.end() )
+    {
+        text = this->corpora.insert( wordCount, SyntheticData::corpus( wordCount, vocabularySize ) );
+    }
+
+    return text.value();
+}
+
+// generated once per size, returns an empty string on failure
+QString PipelineBenchmark::dictionary( const int entryCount )
+{
+    auto dbName = this->dictionaries.find( entryCount );
+
+    if( dbName == this->dictionaries.end() )
+    {
+        const QString fileName{ this->tempDir.filePath( QString{ "dictionary_%1.db" }.arg( entryCount ) ) };
+
+        // en <-> de, one translation per word
+        const SyntheticData::DictionaryOptions options{ 2, entryCount, 1 };
+
+        if( !SyntheticData::createDictionary( THESAURUS_TEMPLATE_DB, fileName, options ) )
+        {
+            return QString{};
+        }
+
+        dbName = this->dictionaries.insert( entryCount, fileName );
+    }
+
+    return dbName.value();
+}
+
+TokenStore PipelineBenchmark::translatedWords( const int wordCount )
+{
+    TokenStore translated_words;
+
+    const QString dbName{ this->dictionary( renderDictionarySize ) };
+
+    if( dbName.isEmpty() )
+    {
+        return translated_words;
+    }
+
+    DB_Manager dbManager{ nullptr, dbName, "benchmark" };
+
+    DictionaryIndex dictionaryIndex;
+    dictionaryIndex.build( dbManager.getAllTranslations( foreignLangId, nativeLangId ) );
+
+    const TextAnalyser analyser{ TextAnalyser::defaultWordSeperators() };
+    TranslationCache cachedTranslations;
+
+    analyser.tokenise( this->corpus( wordCount ), translated_words );
+    analyser.buildTranslationStructure( translated_words, dictionaryIndex, cachedTranslations );
+
+    return translated_words;
+}
+
+// every instruction set this machine supports on an English and a German text of 1M words
+void PipelineBenchmark::tokenise_data()
+{
+    QTest::addColumn<Tokenizer::InstructionSet>( "instructionSet" );
+    QTest::addColumn<bool>( "german" );
+
+    for( const Tokenizer::InstructionSet instructionSet : TestFixtures::supportedInstructionSets() )
+    {
+        for( const bool german : { false, true } )
+        {
+            const QString language{ german ? ", German" : ", English" };
+
+            QTest::newRow( qPrintable( TestFixtures::instructionSetName( instructionSet ) + language ) )
+                    << instructionSet << german;
+        }
+    }
+}
+
+void PipelineBenchmark::tokenise()
+{
+    QFETCH( Tokenizer::InstructionSet, instructionSet );
+    QFETCH( bool, german );
+
+    const QString text{ german ? germanText( this->corpus( 1000000 ) ) : this->corpus( 1000000 ) };
+    const Tokenizer tokenizer{ TextAnalyser::defaultWordSeperators(), instructionSet };
+
+    // the vectorised paths have to split the text exactly like the scalar one
+    TokenStore expected;
+    Tokenizer{ TextAnalyser::defaultWordSeperators(), Tokenizer::InstructionSet::SCALAR }.tokenise( text, expected );
+
+    TokenStore tokens;
+    tokenizer.tokenise( text, tokens );
+
+    QCOMPARE( tokens.size(), expected.size() );
+
+    int firstDifference{ -1 };
+
+    for( int i = 0; i < tokens.size() && firstDifference < 0; ++i )
+    {
+        if( tokens.offset( i ) != expected.offset( i ) || tokens.length( i ) != expected.length( i ) ||
+            tokens.type( i ) != expected.type( i ) )
+        {
+            firstDifference = i;
+        }
+    }
+
+    QCOMPARE( firstDifference, -1 );
+
+    QBENCHMARK
+    {
+        TokenStore benchmarkTokens;
+        tokenizer.tokenise( text, benchmarkTokens );
+    }
+}
+
+// a corpus of several MiB, reported as MiB of UTF-16 text per second
+void PipelineBenchmark::tokeniseThroughput()
+{
+    const QString &text{ this->corpus( 1000000 ) };
+    const Tokenizer tokenizer{ TextAnalyser::defaultWordSeperators() };
+
+    const double mebibytes = text.size() * 2 / ( 1024.0 * 1024.0 );
+    qint64 rounds{ 0 };
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QBENCHMARK
+    {
+        TokenStore tokens;
+        tokenizer.tokenise( text, tokens );
+        ++rounds;
+    }
+
+    const double seconds = timer.nsecsElapsed() / 1e9;
+
+    qInfo( "%.1f MiB tokenised %lld times: %.1f MiB/s", mebibytes, rounds, mebibytes * rounds / seconds );
+}
+
+void PipelineBenchmark::getTranslations_data()
+{
+    QTest::addColumn<int>( "entryCount" );
+    QTest::addColumn<bool>( "statementCache" );
+
+    for( const int size : sizes )
+    {
+        QTest::newRow( qPrintable( sizeLabel( size ) + " entries, no statement cache" ) ) << size << false;
+        QTest::newRow( qPrintable( sizeLabel( size ) + " entries, warm statement cache" ) ) << size << true;
+    }
+}
+
+// 1000 single lookups, half of them unknown. Without the statement cache every
+// lookup prepares its query again, as before DB_Manager cached them
+void PipelineBenchmark::getTranslations()
+{
+    QFETCH( int, entryCount );
+    QFETCH( bool, statementCache );
+
+    const QString dbName{ this->dictionary( entryCount ) };
+    QVERIFY( !dbName.isEmpty() );
+
+    DB_Manager dbManager{ nullptr, dbName, "benchmark" };
+    dbManager.setStatementCacheEnabled( statementCache );
+
+    const QVector<QString> words{ lookupWords( entryCount ) };
+
+    // prepares the cached statement, the first run isn't measured
+    for( const QString &word : words )
+    {
+        dbManager.getTanslations( word, foreignLangId, nativeLangId );
+    }
+
+    QBENCHMARK
+    {
+        for( const QString &word : words )
+        {
+            dbManager.getTanslations( word, foreignLangId, nativeLangId );
+        }
+    }
+}
+
+void PipelineBenchmark::getTranslationsBatch_data()
+{
+    this->addDictionaryRows();
+}
+
+// the same 1000 words as getTranslations(), resolved at once
+void PipelineBenchmark::getTranslationsBatch()
+{
+    QFETCH( int, entryCount );
+
+    const QString dbName{ this->dictionary( entryCount ) };
+    QVERIFY( !dbName.isEmpty() );
+
+    DB_Manager dbManager{ nullptr, dbName, "benchmark" };
+    const QVector<QString> words{ lookupWords( entryCount ) };
+
+    QBENCHMARK
+    {
+        dbManager.getTranslationsBatch( words, foreignLangId, nativeLangId );
+    }
+}
+
+void PipelineBenchmark::loadDictionaryIndex_data()
+{
+    this->addDictionaryRows();
+}
+
+void PipelineBenchmark::loadDictionaryIndex()
+{
+    QFETCH( int, entryCount );
+
+    const QString dbName{ this->dictionary( entryCount ) };
+    QVERIFY( !dbName.isEmpty() );
+
+    DB_Manager dbManager{ nullptr, dbName, "benchmark" };
+
+    QBENCHMARK
+    {
+        DictionaryIndex dictionaryIndex;
+        dictionaryIndex.build( dbManager.getAllTranslations( foreignLangId, nativeLangId ) );
+    }
+}
+
+void PipelineBenchmark::mapDictionaryIndex_data()
+{
+    this->addDictionaryRows();
+}
+
+// opening the exported dictionary file plus a single lookup, the counterpart of loadDictionaryIndex
+void PipelineBenchmark::mapDictionaryIndex()
+{
+    QFETCH( int, entryCount );
+
+    const QString dbName{ this->dictionary( entryCount ) };
+    QVERIFY( !dbName.isEmpty() );
+
+    DB_Manager dbManager{ nullptr, dbName, "benchmark" };
+
+    const QString fileName{ dbManager.getDictionaryFileName( foreignLangId, nativeLangId ) };
+    dbManager.exportDictionary( fileName, foreignLangId, nativeLangId );
+
+    const QString foreignLang{ dbManager.getLangTag( foreignLangId ) };
+    const QString nativeLang{ dbManager.getLangTag( nativeLangId ) };
+    const QString lookedUp{ SyntheticData::word( entryCount / 2 ) };
+
+    QBENCHMARK
+    {
+        DictionaryIndex dictionaryIndex;
+        QVERIFY( dictionaryIndex.map( fileName, foreignLang, nativeLang ) );
+        dictionaryIndex.getTranslations( lookedUp );
+    }
+}
+
+void PipelineBenchmark::mappedLookup_data()
+{
+    this->addDictionaryRows();
+}
+
+// the 1000 lookups of getTranslations in a mapped dictionary, the unknown half is left to its Bloom filter
+void PipelineBenchmark::mappedLookup()
+{
+    QFETCH( int, entryCount );
+
+    const QString dbName{ this->dictionary( entryCount ) };
+    QVERIFY( !dbName.isEmpty() );
+
+    DB_Manager dbManager{ nullptr, dbName, "benchmark" };
+
+    const QString fileName{ dbManager.getDictionaryFileName( foreignLangId, nativeLangId ) };
+    dbManager.exportDictionary( fileName, foreignLangId, nativeLangId );
+
+    DictionaryIndex dictionaryIndex;
+    QVERIFY( dictionaryIndex.map( fileName, dbManager.getLangTag( foreignLangId ),
+                                  dbManager.getLangTag( nativeLangId ) ) );
+
+    const QVector<QString> words{ lookupWords( entryCount ) };
+
+    QBENCHMARK
+    {
+        for( const QString &word : words )
+        {
+            dictionaryIndex.getTranslations( word );
+        }
+    }
+
+    const BloomFilterStatistics filter{ dictionaryIndex.getFilterStatistics() };
+    const quint64 missing{ filter.rejected + filter.falsePositives };
+
+    qInfo( "%llu of %llu lookups skipped, false positive rate %.2f%% (expected %.2f%%)",
+           filter.rejected, filter.lookups,
+           ( missing > 0 ) ? filter.falsePositives * 100.0 / missing : 0.0,
+           filter.expectedFalsePositiveRate * 100.0 );
+}
+
+void PipelineBenchmark::buildTranslationStructure_data()
+{
+    QTest::addColumn<int>( "wordCount" );
+    QTest::addColumn<int>( "entryCount" );
+
+    for( const int wordCount : sizes )
+    {
+        for( const int entryCount : sizes )
+        {
+            QTest::newRow( qPrintable( sizeLabel( wordCount ) + " words, " + sizeLabel( entryCount ) + " entries" ) )
+                    << wordCount << entryCount;
+        }
+    }
+}
+
+// starts with an empty cache in every iteration, like the first analysis of a session
+void PipelineBenchmark::buildTranslationStructure()
+{
+    QFETCH( int, wordCount );
+    QFETCH( int, entryCount );
+
+    const QString dbName{ this->dictionary( entryCount ) };
+    QVERIFY( !dbName.isEmpty() );
+
+    DictionaryIndex dictionaryIndex;
+
+    {
+        DB_Manager dbManager{ nullptr, dbName, "benchmark" };
+        dictionaryIndex.build( dbManager.getAllTranslations( foreignLangId, nativeLangId ) );
+    }
+
+    const TextAnalyser analyser{ TextAnalyser::defaultWordSeperators() };
+
+    TokenStore foreign_words;
+    QVERIFY( analyser.tokenise( this->corpus( wordCount ), foreign_words ) );
+
+    QBENCHMARK
+    {
+        TranslationCache cachedTranslations;
+
+        analyser.buildTranslationStructure( foreign_words, dictionaryIndex, cachedTranslations );
+    }
+}
+
+void PipelineBenchmark::translationCache_data()
+{
+    QTest::addColumn<qint64>( "memoryBudget" );
+
+    QTest::newRow( "64 KiB" ) << qint64{ 64 * 1024 };
+    QTest::newRow( "1 MiB" ) << qint64{ 1024 * 1024 };
+    QTest::newRow( "16 MiB" ) << TranslationCache::defaultMemoryBudget;
+}
+
+// analysing the same text again with the cache of the first analysis, like re-rendering in a session
+void PipelineBenchmark::translationCache()
+{
+    QFETCH( qint64, memoryBudget );
+
+    const QString dbName{ this->dictionary( renderDictionarySize ) };
+    QVERIFY( !dbName.isEmpty() );
+
+    DictionaryIndex dictionaryIndex;
+
+    {
+        DB_Manager dbManager{ nullptr, dbName, "benchmark" };
+        dictionaryIndex.build( dbManager.getAllTranslations( foreignLangId, nativeLangId ) );
+    }
+
+    const TextAnalyser analyser{ TextAnalyser::defaultWordSeperators() };
+
+    TokenStore foreign_words;
+    QVERIFY( analyser.tokenise( this->corpus( 1000000 ), foreign_words ) );
+
+    TranslationCache cachedTranslations{ memoryBudget };
+
+    analyser.buildTranslationStructure( foreign_words, dictionaryIndex, cachedTranslations );
+    cachedTranslations.resetStatistics();
+
+    QBENCHMARK
+    {
+        analyser.buildTranslationStructure( foreign_words, dictionaryIndex, cachedTranslations );
+    }
+
+    qInfo( "%d words cached in %lld KiB, hit rate %.1f%%", cachedTranslations.size(),
+           cachedTranslations.getMemoryUsage() / 1024, cachedTranslations.getHitRate() * 100.0 );
+}
+
+// heap memory of an analysed text of about 1M tokens, compared with one object per token
+// holding its own content string and a vector of translations shared by its word
+void PipelineBenchmark::tokenStoreFootprint()
+{
+    // about as many links as words
+    const TokenStore translated_words{ this->translatedWords( 500000 ) };
+    QVERIFY( !translated_words.isEmpty() );
+
+    struct TokenObject
+    {
+        QString content;
+        QVector<QString> translations;
+        TYPE type;
+    };
+
+    // QArrayData header plus the allocation granularity, as estimated by TokenStore
+    const qint64 allocationOverhead{ 32 };
+
+    qint64 objectBytes = allocationOverhead + translated_words.size() * static_cast<qint64>( sizeof( TokenObject ) );
+
+    for( int i = 0; i < translated_words.size(); ++i )
+    {
+        // links were padded with two spaces
+        const int length = translated_words.length( i ) + ( translated_words.isWordType( i ) ? 0 : 2 );
+        objectBytes += allocationOverhead + length * 2;
+    }
+
+    for( int wordType = 0; wordType < translated_words.wordTypeCount(); ++wordType )
+    {
+        const QVector<int> translationIds{ translated_words.wordTypeTranslationIds( wordType ) };
+
+        if( !translationIds.isEmpty() )
+        {
+            objectBytes += allocationOverhead + translationIds.size() * static_cast<qint64>( sizeof( QString ) );
+        }
+
+        for( const int translationId : translationIds )
+        {
+            objectBytes += allocationOverhead + translated_words.string( translationId ).size() * 2;
+        }
+    }
+
+    const qint64 storeBytes = translated_words.memoryUsage();
+
+    qInfo( "%d tokens, %d word types: one object per token %lld KiB, token store %lld KiB (%.1fx smaller)",
+           translated_words.size(), translated_words.wordTypeCount(), objectBytes / 1024, storeBytes / 1024,
+           static_cast<double>( objectBytes ) / storeBytes );
+
+    QVERIFY( storeBytes < objectBytes );
+}
+
+void PipelineBenchmark::buildLayout_data()
+{
+    this->addCorpusRows();
+}
+
+// line and word positions plus statistics, formerly part of newText()
+void PipelineBenchmark::buildLayout()
+{
+    QFETCH( int, wordCount );
+
+    const TokenStore translated_words{ this->translatedWords( wordCount ) };
+    QVERIFY( !translated_words.isEmpty() );
+
+    TextRenderer renderer{ QFont{ "Courier" }, TestFixtures::textColors() };
+
+    QBENCHMARK
+    {
+        renderer.buildLayout( translated_words );
+    }
+}
+
+void PipelineBenchmark::renderLines_data()
+{
+    this->addCorpusRows();
+}
+
+// merging every foreign line with its native line, formerly mergeLanguages()
+void PipelineBenchmark::renderLines()
+{
+    QFETCH( int, wordCount );
+
+    const TokenStore translated_words{ this->translatedWords( wordCount ) };
+    QVERIFY( !translated_words.isEmpty() );
+
+    TextRenderer renderer{ QFont{ "Courier" }, TestFixtures::textColors() };
+    renderer.buildLayout( translated_words );
+
+    const TextLayout &layout{ renderer.getLayout() };
+
+    QBENCHMARK
+    {
+        for( int line = 0; line < layout.lineFirstToken.size(); ++line )
+        {
+            renderer.renderLine( translated_words, layout, line );
+        }
+    }
+}
+
+void PipelineBenchmark::renderDocument_data()
+{
+    this->addCorpusRows();
+}
+
+// the whole document textEdit shows, formerly built as HTML and passed to setHtml()
+void PipelineBenchmark::renderDocument()
+{
+    QFETCH( int, wordCount );
+
+    const TokenStore translated_words{ this->translatedWords( wordCount ) };
+    QVERIFY( !translated_words.isEmpty() );
+
+    TextRenderer renderer{ QFont{ "Courier" }, TestFixtures::textColors() };
+
+    QBENCHMARK
+    {
+        delete renderer.render( translated_words );
+    }
+}
+
+void PipelineBenchmark::renderDocumentVsHtml_data()
+{
+    QTest::addColumn<bool>( "html" );
+
+    QTest::newRow( qPrintable( sizeLabel( renderLineCount ) + " lines, QTextDocument" ) ) << false;
+    QTest::newRow( qPrintable( sizeLabel( renderLineCount ) + " lines, HTML and setHtml() (old)" ) ) << true;
+}
+
+// the view of a 10k line text, rendered into the document directly and the way it was
+// done before: one HTML string, parsed by the document again
+void PipelineBenchmark::renderDocumentVsHtml()
+{
+    QFETCH( bool, html );
+
+    const TokenStore translated_words{ this->translatedWords( renderLineCount * wordsPerLine ) };
+    QVERIFY( !translated_words.isEmpty() );
+
+    const QFont font{ "Courier" };
+
+    if( html )
+    {
+        const HtmlReferenceRenderer renderer{ TestFixtures::textColors() };
+
+        QBENCHMARK
+        {
+            QTextDocument document;
+            document.setDefaultFont( font );
+            document.setHtml( renderer.render( translated_words ) );
+        }
+    }
+    else
+    {
+        TextRenderer renderer{ font, TestFixtures::textColors() };
+
+        QBENCHMARK
+        {
+            delete renderer.render( translated_words );
+        }
+
+        QVERIFY( renderer.getLayout().lineFirstToken.size() >= renderLineCount );
+    }
+}
+
+void PipelineBenchmark::logCall_data()
+{
+    QTest::addColumn<bool>( "asynchronous" );
+    QTest::addColumn<int>( "loadThreads" );
+
+    QTest::newRow( "synchronous, idle" ) << false << 0;
+    QTest::newRow( "synchronous, 4 threads logging" ) << false << 4;
+    QTest::newRow( "asynchronous, idle" ) << true << 0;
+    QTest::newRow( "asynchronous, 4 threads logging" ) << true << 4;
+}
+
+// latency of a single logInfo() call, while other threads may log as well
+void PipelineBenchmark::logCall()
+{
+    QFETCH( bool, asynchronous );
+    QFETCH( int, loadThreads );
+
+    LogOptions logOptions{ ::defaultLogOptions() };
+    logOptions.mode = asynchronous ? LogMode::ASYNCHRONOUS : LogMode::SYNCHRONOUS;
+    logOptions.echoToDebugOutput = false;
+    ::init_log( this->logFile.toStdString().c_str(), logOptions );
+
+    std::atomic<bool> running{ true };
+    std::vector<std::thread> threads;
+
+    for( int i = 0; i < loadThreads; ++i )
+    {
+        threads.emplace_back( [&running]()
+        {
+            while( running )
+            {
+                ::logInfo( "Background message of the benchmark" );
+            }
+        } );
+    }
+
+    const QString message{ "Dictionary index loaded: 100000 words" };
+
+    QBENCHMARK
+    {
+        ::logInfo( message );
+    }
+
+    running = false;
+
+    for( std::thread &thread : threads )
+    {
+        thread.join();
+    }
+
+    ::shutdown_log();
+}
+
+int main( int argc, char *argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    QStringList arguments{ app.arguments() };
+
+    // machine readable results to track them over time, plus the usual output
+    if( !arguments.contains( "-o" ) )
+    {
+        arguments << "-o" << "benchmark_results.xml,xml" << "-o" << "-,txt";
+    }
+
+    PipelineBenchmark benchmark;
+
+    return QTest::qExec( &benchmark, arguments );
+}
+
+#include "pipelinebenchmark.moc"
@@ -0,0 +1,287 @@
+#include "analysejob.h"
+
+#include <QTextDocument>
+#include <QThread>
+#include <QtConcurrent>
+
+#include "db_manager.h"
+#include "log.h"
+#include "textanalyser.h"
+
+AnalyseJob::AnalyseJob( QObject *parent, const AnalyseInput &input )
+: QObject{ parent }
+, input{ input }
+, result{}
+, cancelled{ false }
+, lastReportedPercent{ -1 }
+, targetThread{ this->thread() }
+{
+    this->result.document = nullptr;
+    this->result.knownWords = 0;
+    this->result.unknownWords = 0;
+    this->result.cachedTranslations = input.cachedTranslations;
+    this->result.cacheGeneration = input.cacheGeneration;
+    this->result.dictionaryIndex = input.dictionaryIndex;
+    this->result.indexedForeignLangId = input.indexedForeignLangId;
+    this->result.indexedNativeLangId = input.indexedNativeLangId;
+
+    QObject::connect( &this->watcher, &QFutureWatcher<void>::finished,
+                      this, &AnalyseJob::onWorkerFinished,
+                      Qt::UniqueConnection );
+}
+
+AnalyseJob::~AnalyseJob()
+{
+    // the worker uses this object, it has to return before we are gone
+    this->cancel();
+    this->watcher.waitForFinished();
+
+    delete this->result.document;
+}
+
+void AnalyseJob::start()
+{
+    this->watcher.setFuture( QtConcurrent::run( this, &AnalyseJob::run ) );
+}
+
+void AnalyseJob::cancel()
+{
+    this->cancelled = true;
+}
+
+bool AnalyseJob::isCancelled() const
+{
+    return this->cancelled;
+}
+
+const AnalyseResult &AnalyseJob::getResult() const
+{
+    return this->result;
+}
+
+QTextDocument *AnalyseJob::takeDocument()
+{
+    QTextDocument *document = this->result.document;
+    this->result.document = nullptr;
+
+    return document;
+}
+
+void AnalyseJob::onWorkerFinished()
+{
+    if( this->isCancelled() )
+    {
+        this->deleteLater();
+    }
+    else
+    {
+        emit finished();
+    }
+}
+
+// runs on a worker thread!
+void AnalyseJob::run()
+{
+    // every job gets its own named connection, it is removed when dbManager is destroyed
+    static std::atomic<int> jobCounter{ 0 };
+    const QString connectionName{ QString{ "analyse_job_%1" }.arg( ++jobCounter ) };
+
+    try
+    {
+        DB_Manager dbManager{ nullptr, this->input.dbName, connectionName };
+
+        if( !this->tokenise() ||
+            !this->buildTranslationStructure( dbManager ) )
+        {
+            return;
+        }
+
+        TextRenderer renderer{ this->input.font, this->input.textColors };
+
+        if( this->input.renderDocument )
+        {
+            this->result.document = renderer.render( this->result.foreignWords,
+                [this]( const int done, const int total )
+                {
+                    return this->reportProgress( "Rendering", done, total );
+                } );
+
+            if( this->result.document == nullptr )
+            {
+                return;
+            }
+
+            // the document was created on this worker thread, the GUI thread takes it over
+            this->result.document->moveToThread( this->targetThread );
+        }
+        else
+        {
+            renderer.buildLayout( this->result.foreignWords );
+        }
+
+        this->result.layout = renderer.getLayout();
+        this->result.knownWords = renderer.getKnownWords();
+        this->result.unknownWords = renderer.getUnknownWords();
+    }
+    catch( const QString &error )
+    {
+        this->result.error = error;
+    }
+    catch( const char *error )
+    {
+        ::logError( error );
+        this->result.error = error;
+    }
+}
+
+bool AnalyseJob::tokenise()
+{
+    const TextAnalyser analyser{ this->input.wordSeperators };
+
+    return analyser.tokenise( this->input.text, this->result.foreignWords,
+                              [this]( const QString &stage, const int done, const int total )
+                              {
+                                  return this->reportProgress( stage, done, total );
+                              } )
+            && !this->isCancelled();
+}
+
+bool AnalyseJob::buildTranslationStructure( DB_Manager &dbManager )
+{
+    // get lang ids
+    const int foreignLangId = dbManager.getLangId( this->input.foreignLangTag.toLower() );
+    const int nativeLangId = dbManager.getLangId( this->input.nativeLangTag.toLower() );
+
+    this->loadDictionaryIndex( foreignLangId, nativeLangId, dbManager );
+
+    const TextAnalyser analyser{ this->input.wordSeperators };
+
+    return analyser.buildTranslationStructure( this->result.foreignWords,
+                                               this->result.dictionaryIndex,
+                                               this->result.cachedTranslations,
+                                               [this]( const QString &stage, const int done, const int total )
+                                               {
+                                                   return this->reportProgress( stage, done, total );
+                                               } )
+            && !this->isCancelled();
+}
+
+void AnalyseJob::loadDictionaryIndex( const int foreignLangId, const int nativeLangId, DB_Manager &dbManager )
+{
+    if( foreignLangId == this->result.indexedForeignLangId &&
+        nativeLangId == this->result.indexedNativeLangId )
+    {
+        return;
+    }
+
+    this->reportProgress( "Loading dictionary", 0, 1 );
+
+    // read first, changes while loading make the cache outdated instead of going unnoticed
+    const qint64 generation{ dbManager.getDictionaryGeneration() };
+
+    if( !this->input.mapDictionary || !this->mapDictionaryFile( foreignLangId, nativeLangId, dbManager ) )
+    {
+        this->result.dictionaryIndex.build( dbManager.getAllTranslations( foreignLangId, nativeLangId ) );
+    }
+
+    this->result.indexedForeignLangId = foreignLangId;
+    this->result.indexedNativeLangId = nativeLangId;
+
+    ::logInfo( QString{ "Dictionary index loaded: %1 words%2" }
+               .arg( this->result.dictionaryIndex.size() )
+               .arg( this->result.dictionaryIndex.isMapped() ? " (mapped)" : "" ) );
+
+    // the cache belongs to the language pair of the index
+    this->result.cacheGeneration = generation;
+    this->loadTranslationCache( foreignLangId, nativeLangId, dbManager );
+}
+
+// the cache of an earlier session, if no translation was changed since it was saved
+void AnalyseJob::loadTranslationCache( const int foreignLangId, const int nativeLangId, DB_Manager &dbManager )
+{
+    this->result.cachedTranslations.clear();
+
+    if( !this->input.persistentCache )
+    {
+        return;
+    }
+
+    const QString fileName{ dbManager.getTranslationCacheFileName( foreignLangId, nativeLangId ) };
+
+    if( this->result.cachedTranslations.load( fileName, this->result.cacheGeneration ) )
+    {
+        ::logInfo( QString{ "Translation cache loaded: %1 words" }.arg( this->result.cachedTranslations.size() ) );
+    }
+    else
+    {
+        // missing, outdated or damaged
+        this->result.cachedTranslations.clear();
+    }
+}
+
+// maps the dictionary file of the language pair, it is exported first if it is missing or outdated
+bool AnalyseJob::mapDictionaryFile( const int foreignLangId, const int nativeLangId, DB_Manager &dbManager )
+{
+    const QString fileName{ dbManager.getDictionaryFileName( foreignLangId, nativeLangId ) };
+
+    try
+    {
+        if( !dbManager.isDictionaryFileCurrent( fileName ) )
+        {
+            dbManager.exportDictionary( fileName, foreignLangId, nativeLangId );
+        }
+    }
+    catch( const QString & )
+    {
+        // already logged, e.g. a read-only directory. The index is built from the database then
+        return false;
+    }
+
+    const QString foreignLang{ dbManager.getLangTag( foreignLangId ) };
+    const QString nativeLang{ dbManager.getLangTag( nativeLangId ) };
+
+    if( this->result.dictionaryIndex.map( fileName, foreignLang, nativeLang ) )
+    {
+        dbManager.removeOutdatedDictionaryFiles( foreignLangId, nativeLangId, fileName );
+        return true;
+    }
+
+    // e.g. written by an older version, a fresh export replaces it
+    try
+    {
+        dbManager.exportDictionary( fileName, foreignLangId, nativeLangId );
+    }
+    catch( const QString & )
+    {
+        return false;
+    }
+
+    if( !this->result.dictionaryIndex.map( fileName, foreignLang, nativeLang ) )
+    {
+        ::logError( "Could not map dictionary file " + fileName );
+        return false;
+    }
+
+    dbManager.removeOutdatedDictionaryFiles( foreignLangId, nativeLangId, fileName );
+
+    return true;
+}
+
+bool AnalyseJob::reportProgress( const QString &stage, const int done, const int total )
+{
+    if( this->isCancelled() )
+    {
+        return false;
+    }
+
+    const int percent = ( total > 0 ) ? static_cast<int>( done * 100LL / total ) : 100;
+
+    if( percent != this->lastReportedPercent || stage != this->lastReportedStage )
+    {
+        this->lastReportedPercent = percent;
+        this->lastReportedStage = stage;
+        emit progressChanged( stage, percent );
+    }
+
+    return true;
+}
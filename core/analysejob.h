@@ -0,0 +1,110 @@
+#ifndef ANALYSEJOB_H
+#define ANALYSEJOB_H
+
+#include <QFont>
+#include <QFutureWatcher>
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+
+#include "dictionaryindex.h"
+#include "textrenderer.h"
+#include "tokenstore.h"
+#include "translationcache.h"
+
+// Forward-Declarations
+class DB_Manager;
+class QTextDocument;
+class QThread;
+
+// everything the pipeline needs, captured on the GUI thread
+struct AnalyseInput
+{
+    QString dbName;
+    QString text;
+    QVector<QChar> wordSeperators;
+    QString foreignLangTag;
+    QString nativeLangTag;
+    QFont font;
+    QMap<TextTypeColor, QString> textColors;
+    TranslationCache cachedTranslations;
+    // dictionary generation the cached translations were resolved at
+    qint64 cacheGeneration;
+    DictionaryIndex dictionaryIndex;
+    int indexedForeignLangId;
+    int indexedNativeLangId;
+    // false only builds the layout, the text is shown by a view rendering visible lines itself
+    bool renderDocument;
+    // maps the dictionary file of the language pair instead of building the index from the database
+    bool mapDictionary;
+    // loads the translation cache saved by an earlier session when the language pair changes
+    bool persistentCache;
+};
+
+struct AnalyseResult
+{
+    TokenStore foreignWords;
+    // owned by the job until taken with AnalyseJob::takeDocument(),
+    // nullptr if AnalyseInput::renderDocument was false
+    QTextDocument *document;
+    TextLayout layout;
+    int knownWords;
+    int unknownWords;
+    TranslationCache cachedTranslations;
+    qint64 cacheGeneration;
+    DictionaryIndex dictionaryIndex;
+    int indexedForeignLangId;
+    int indexedNativeLangId;
+    QString error;
+};
+
+// Runs tokenise -> lookup -> render on the global thread pool.
+// The job opens its own database connection, a QSqlDatabase can't be shared across threads.
+class AnalyseJob : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AnalyseJob( QObject *parent, const AnalyseInput &input );
+    ~AnalyseJob() override;
+
+    void start();
+
+    // a cancelled job never emits finished() and deletes itself as soon as the worker returned
+    void cancel();
+    bool isCancelled() const;
+
+    const AnalyseResult &getResult() const;
+
+    // hands the rendered document over to the caller, it lives in the thread the job was created in
+    QTextDocument *takeDocument();
+
+signals:
+    void progressChanged( const QString &stage, const int percent );
+    void finished();
+
+private slots:
+    void onWorkerFinished();
+
+private:
+    void run();
+    bool tokenise();
+    bool buildTranslationStructure( DB_Manager &dbManager );
+    void loadDictionaryIndex( const int foreignLangId, const int nativeLangId, DB_Manager &dbManager );
+    bool mapDictionaryFile( const int foreignLangId, const int nativeLangId, DB_Manager &dbManager );
+    void loadTranslationCache( const int foreignLangId, const int nativeLangId, DB_Manager &dbManager );
+    bool reportProgress( const QString &stage, const int done, const int total );
+
+    AnalyseInput input;
+    AnalyseResult result;
+    std::atomic<bool> cancelled;
+    int lastReportedPercent;
+    QString lastReportedStage;
+    QThread *targetThread;
+    QFutureWatcher<void> watcher;
+};
+
+#endif // ANALYSEJOB_H
@@ -0,0 +1,369 @@
+#include "batchanalysis.h"
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QFuture>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cstring>
+
+#include "db_manager.h"
+#include "dictionaryfile.h"
+#include "log.h"
+#include "textanalyser.h"
+
+namespace
+{
+    const char *const analyseSwitch{ "--analyse" };
+
+    double knownPercent( const FileReport &report )
+    {
+        const int sum = report.knownWords + report.unknownWords;
+
+        return ( sum > 0 ) ? report.knownWords * 100.0 / sum : 0.0;
+    }
+
+    // quotes field if needed, see RFC 4180
+    QString csvField( const QString &field )
+    {
+        if( !field.contains( ',' ) && !field.contains( '"' ) &&
+            !field.contains( '\n' ) && !field.contains( '\r' ) )
+        {
+            return field;
+        }
+
+        QString quoted{ field };
+        quoted.replace( "\"", "\"\"" );
+
+        return "\"" + quoted + "\"";
+    }
+}
+
+bool BatchAnalysis::isRequested( int argc, char *argv[] )
+{
+    for( int i = 1; i < argc; ++i )
+    {
+        if( std::strcmp( argv[i], analyseSwitch ) == 0 )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int BatchAnalysis::run( const QStringList &arguments )
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Analyses text files without starting the user interface." );
+    parser.addHelpOption();
+
+    const QCommandLineOption analyseOption{ "analyse", "Analyse the given files and exit." };
+    const QCommandLineOption formatOption{ "format", "Format of the report: json or csv.", "format", "json" };
+    const QCommandLineOption outputOption{ QStringList{ "o", "output" },
+                                           "Write the report to <file> instead of stdout.", "file" };
+    const QCommandLineOption foreignOption{ "foreign",
+                                            "Language of the files, default is the foreign language of the settings.",
+                                            "lang" };
+    const QCommandLineOption nativeOption{ "native",
+                                           "Language of the translations, default is the native language of the settings.",
+                                           "lang" };
+    const QCommandLineOption dbOption{ "db", "Dictionary database.", "file", "mycutethesaurus.db" };
+    const QCommandLineOption dictionaryOption{ "dictionary",
+                                               "Exported dictionary file to use instead of the database, "
+                                               "it contains the languages as well, "
+                                               "given --foreign and --native have to match them.",
+                                               "file" };
+
+    parser.addOptions( { analyseOption, formatOption, outputOption, foreignOption, nativeOption,
+                         dbOption, dictionaryOption } );
+    parser.addPositionalArgument( "files", "Text files to analyse.", "<files...>" );
+
+    // exits on --help and unknown options
+    parser.process( arguments );
+
+    QTextStream errorStream{ stderr };
+
+    const QStringList files{ parser.positionalArguments() };
+
+    if( files.isEmpty() )
+    {
+        errorStream << "No files to analyse given." << endl;
+        return 1;
+    }
+
+    const QString format{ parser.value( formatOption ).toLower() };
+
+    if( format != "json" && format != "csv" )
+    {
+        errorStream << "Unknown format: " << format << endl;
+        return 1;
+    }
+
+    QString foreignLangTag;
+    QString nativeLangTag;
+    DictionaryIndex dictionaryIndex;
+
+    // runs without SQLite at all, the file is mapped like the user interface does
+    if( parser.isSet( dictionaryOption ) )
+    {
+        const QString fileName{ parser.value( dictionaryOption ) };
+        const QPair<QString, QString> languages{ DictionaryFile::readLanguages( fileName ) };
+
+        if( languages.first.isEmpty() || languages.second.isEmpty() )
+        {
+            errorStream << "Not a dictionary file: " << fileName << endl;
+            return 1;
+        }
+
+        foreignLangTag = languages.first;
+        nativeLangTag = languages.second;
+
+        if( ( parser.isSet( foreignOption ) && parser.value( foreignOption ).toLower() != foreignLangTag ) ||
+            ( parser.isSet( nativeOption ) && parser.value( nativeOption ).toLower() != nativeLangTag ) )
+        {
+            errorStream << fileName << " translates " << foreignLangTag << " to " << nativeLangTag
+                        << ", not the given languages" << endl;
+            return 1;
+        }
+
+        if( !dictionaryIndex.map( fileName, foreignLangTag, nativeLangTag ) )
+        {
+            errorStream << "Can't open " << fileName << ": the dictionary file is damaged" << endl;
+            return 1;
+        }
+    }
+    else
+    {
+        try
+        {
+            DB_Manager dbManager{ nullptr, parser.value( dbOption ), "batch_analysis" };
+
+            if( !dbManager.isOk() )
+            {
+                errorStream << "Not a dictionary database: " << parser.value( dbOption ) << endl;
+                return 1;
+            }
+
+            foreignLangTag = parser.isSet( foreignOption ) ? parser.value( foreignOption ).toLower()
+                                                           : dbManager.getCurrentForeignLang();
+            nativeLangTag = parser.isSet( nativeOption ) ? parser.value( nativeOption ).toLower()
+                                                         : dbManager.getCurrentNativeLang();
+
+            const int foreignLangId = dbManager.getLangId( foreignLangTag );
+            const int nativeLangId = dbManager.getLangId( nativeLangTag );
+
+            if( foreignLangId == 0 || nativeLangId == 0 )
+            {
+                errorStream << "Unknown language: " << ( foreignLangId == 0 ? foreignLangTag : nativeLangTag ) << endl;
+                return 1;
+            }
+
+            dictionaryIndex.build( dbManager.getAllTranslations( foreignLangId, nativeLangId ) );
+        }
+        catch( const QString &error )
+        {
+            errorStream << error << endl;
+            return 1;
+        }
+        catch( const char *error )
+        {
+            ::logError( error );
+            errorStream << error << endl;
+            return 1;
+        }
+    }
+
+    ::logInfo( QString{ "Batch analysis of %1 files, dictionary: %2 words" }
+               .arg( files.size() ).arg( dictionaryIndex.size() ) );
+
+    const BatchAnalysis batchAnalysis{ dictionaryIndex };
+    const QVector<FileReport> reports{ batchAnalysis.analyse( files ) };
+
+    const QByteArray report{ ( format == "json" ) ? BatchAnalysis::toJson( reports, foreignLangTag, nativeLangTag )
+                                                  : BatchAnalysis::toCsv( reports ) };
+
+    QFile output;
+
+    if( parser.isSet( outputOption ) )
+    {
+        output.setFileName( parser.value( outputOption ) );
+
+        if( !output.open( QFile::WriteOnly | QFile::Truncate ) )
+        {
+            errorStream << "Can't write " << output.fileName() << ": " << output.errorString() << endl;
+            return 1;
+        }
+    }
+    else
+    {
+        output.open( stdout, QFile::WriteOnly );
+    }
+
+    output.write( report );
+    output.close();
+
+    const bool failed = std::any_of( reports.begin(), reports.end(),
+                                     []( const FileReport &fileReport ) { return !fileReport.error.isEmpty(); } );
+
+    return failed ? 2 : 0;
+}
+
+QByteArray BatchAnalysis::toJson( const QVector<FileReport> &reports,
+                                  const QString &foreignLangTag, const QString &nativeLangTag )
+{
+    QJsonArray files;
+
+    for( const FileReport &report : reports )
+    {
+        QJsonObject file;
+        file.insert( "file", report.fileName );
+
+        if( !report.error.isEmpty() )
+        {
+            file.insert( "error", report.error );
+            files.append( file );
+            continue;
+        }
+
+        QJsonArray unknownWords;
+
+        for( const QPair<QString, int> &unknownWord : report.unknownWordCounts )
+        {
+            unknownWords.append( QJsonObject{ { "word", unknownWord.first },
+                                              { "count", unknownWord.second } } );
+        }
+
+        file.insert( "words", report.knownWords + report.unknownWords );
+        file.insert( "knownWords", report.knownWords );
+        file.insert( "unknownWords", report.unknownWords );
+        file.insert( "knownPercent", qRound( knownPercent( report ) * 100.0 ) / 100.0 );
+        file.insert( "unknownWordList", unknownWords );
+
+        files.append( file );
+    }
+
+    const QJsonObject root{ { "foreignLanguage", foreignLangTag },
+                            { "nativeLanguage", nativeLangTag },
+                            { "files", files } };
+
+    return QJsonDocument{ root }.toJson( QJsonDocument::Indented );
+}
+
+// one row per file, the unknown words are joined by ';'
+QByteArray BatchAnalysis::toCsv( const QVector<FileReport> &reports )
+{
+    QString csv{ "file,words,known_words,unknown_words,known_percent,unknown_word_list,error\n" };
+
+    for( const FileReport &report : reports )
+    {
+        QStringList unknownWords;
+
+        for( const QPair<QString, int> &unknownWord : report.unknownWordCounts )
+        {
+            unknownWords.append( unknownWord.first );
+        }
+
+        csv.append( QStringList{ csvField( report.fileName ),
+                                 QString::number( report.knownWords + report.unknownWords ),
+                                 QString::number( report.knownWords ),
+                                 QString::number( report.unknownWords ),
+                                 QString::number( knownPercent( report ), 'f', 2 ),
+                                 csvField( unknownWords.join( ';' ) ),
+                                 csvField( report.error ) }.join( ',' ) );
+        csv.append( '\n' );
+    }
+
+    return csv.toUtf8();
+}
+
+BatchAnalysis::BatchAnalysis( const DictionaryIndex &dictionaryIndex )
+: dictionaryIndex{ dictionaryIndex }
+{
+}
+
+QVector<FileReport> BatchAnalysis::analyse( const QStringList &files ) const
+{
+    QVector<QFuture<FileReport>> futures;
+    futures.reserve( files.size() );
+
+    // one task per file, the global thread pool runs as many at once as there are cores
+    for( const QString &fileName : files )
+    {
+        futures.push_back( QtConcurrent::run( this, &BatchAnalysis::analyseFile, fileName ) );
+    }
+
+    QVector<FileReport> reports;
+    reports.reserve( files.size() );
+
+    for( QFuture<FileReport> &future : futures )
+    {
+        reports.push_back( future.result() );
+    }
+
+    return reports;
+}
+
+// runs on a worker thread, only reads the shared dictionaryIndex
+FileReport BatchAnalysis::analyseFile( const QString &fileName ) const
+{
+    FileReport report{ fileName, QString{}, 0, 0, QVector<QPair<QString, int>>{} };
+
+    QFile file{ fileName };
+
+    if( !file.open( QFile::ReadOnly | QFile::Text ) )
+    {
+        report.error = file.errorString();
+        return report;
+    }
+
+    QTextStream fileStream( &file );
+    const QString text{ fileStream.readAll() };
+
+    const TextAnalyser analyser{ TextAnalyser::defaultWordSeperators() };
+
+    TokenStore foreign_words;
+    TranslationCache cachedTranslations;
+
+    analyser.tokenise( text, foreign_words );
+    analyser.buildTranslationStructure( foreign_words, this->dictionaryIndex, cachedTranslations );
+
+    // occurrences of every word type
+    QVector<int> wordTypeCounts( foreign_words.wordTypeCount(), 0 );
+
+    for( int i = 0; i < foreign_words.size(); ++i )
+    {
+        if( foreign_words.isWordType( i ) )
+        {
+            ++wordTypeCounts[foreign_words.wordType( i )];
+        }
+    }
+
+    for( int wordType = 0; wordType < wordTypeCounts.size(); ++wordType )
+    {
+        if( !foreign_words.wordTypeTranslationIds( wordType ).isEmpty() )
+        {
+            report.knownWords += wordTypeCounts.at( wordType );
+        }
+        else
+        {
+            report.unknownWords += wordTypeCounts.at( wordType );
+            report.unknownWordCounts.push_back( qMakePair( foreign_words.wordTypeContent( wordType ),
+                                                           wordTypeCounts.at( wordType ) ) );
+        }
+    }
+
+    std::sort( report.unknownWordCounts.begin(), report.unknownWordCounts.end(),
+               []( const QPair<QString, int> &a, const QPair<QString, int> &b )
+               {
+                   return ( a.second != b.second ) ? a.second > b.second : a.first < b.first;
+               } );
+
+    return report;
+}
@@ -0,0 +1,59 @@
+#ifndef BATCHANALYSIS_H
+#define BATCHANALYSIS_H
+
+#include <QByteArray>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "dictionaryindex.h"
+
+// statistics of one analysed file
+struct FileReport
+{
+    QString fileName;
+    // empty if the file could be analysed
+    QString error;
+    int knownWords;
+    int unknownWords;
+    // distinct unknown words and how often each occurs, most frequent first
+    QVector<QPair<QString, int>> unknownWordCounts;
+};
+
+// Headless analysis of whole files, started with "--analyse <files...>".
+// Doesn't need any widget, so it runs on a QCoreApplication.
+//
+// The dictionary of the language pair is loaded once, then all files are
+// analysed in parallel on the global thread pool, sharing the read-only index.
+class BatchAnalysis
+{
+public:
+    enum class OutputFormat
+    {
+        JSON,
+        CSV
+    };
+
+    // true if the command line asks for the batch mode
+    static bool isRequested( int argc, char *argv[] );
+
+    // parses the command line, analyses the files and writes the report.
+    // Returns the exit code of the process
+    static int run( const QStringList &arguments );
+
+    static QByteArray toJson( const QVector<FileReport> &reports,
+                              const QString &foreignLangTag, const QString &nativeLangTag );
+    static QByteArray toCsv( const QVector<FileReport> &reports );
+
+    explicit BatchAnalysis( const DictionaryIndex &dictionaryIndex );
+
+    // results are in the order of files
+    QVector<FileReport> analyse( const QStringList &files ) const;
+    FileReport analyseFile( const QString &fileName ) const;
+
+private:
+    DictionaryIndex dictionaryIndex;
+};
+
+#endif // BATCHANALYSIS_H
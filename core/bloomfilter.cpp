@@ -0,0 +1,149 @@
+#include "bloomfilter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // finalizer of SplitMix64, spreads the FNV-1a hash over all 64 bits
+    inline quint64 mix( quint64 hash )
+    {
+        hash = ( hash ^ ( hash >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+        hash = ( hash ^ ( hash >> 27 ) ) * 0x94D049BB133111EBULL;
+
+        return hash ^ ( hash >> 31 );
+    }
+}
+
+quint64 BloomFilter::hash( const QChar *word, const int size )
+{
+    quint64 hash = 0xCBF29CE484222325ULL;
+
+    for( int i = 0; i < size; ++i )
+    {
+        hash = ( hash ^ word[i].unicode() ) * 0x100000001B3ULL;
+    }
+
+    return mix( hash );
+}
+
+BloomFilter::BloomFilter()
+: rawWords{ nullptr }
+, words{ 0 }
+, hashes{ 0 }
+{
+}
+
+BloomFilter::BloomFilter( const int count, const double falsePositiveRate )
+: rawWords{ nullptr }
+, words{ 0 }
+, hashes{ 0 }
+{
+    const double ln2 = std::log( 2.0 );
+
+    // m = -n * ln( p ) / ln( 2 )^2 bits, k = m / n * ln( 2 ) hashes
+    const double bitCount = std::max( 1, count ) * -std::log( falsePositiveRate ) / ( ln2 * ln2 );
+
+    this->words = static_cast<int>( std::ceil( bitCount / 64.0 ) );
+
+    const int hashCount = static_cast<int>( std::lround( this->words * 64.0 / std::max( 1, count ) * ln2 ) );
+    this->hashes = std::min( 16, std::max( 1, hashCount ) );
+    this->bits = QVector<quint64>( this->words, 0 );
+}
+
+BloomFilter BloomFilter::fromRawData( const quint64 *words, const int wordCount, const int hashCount )
+{
+    BloomFilter filter;
+
+    if( words != nullptr && wordCount > 0 && hashCount > 0 )
+    {
+        filter.rawWords = words;
+        filter.words = wordCount;
+        filter.hashes = hashCount;
+    }
+
+    return filter;
+}
+
+void BloomFilter::insert( const QString &word )
+{
+    if( this->isNull() || this->rawWords != nullptr )
+    {
+        return;
+    }
+
+    const quint64 hash = BloomFilter::hash( word.constData(), word.size() );
+    const quint64 bitCount = static_cast<quint64>( this->words ) * 64;
+    const quint64 step = ( hash >> 32 ) | 1;
+
+    quint64 *data = this->bits.data();
+
+    for( int i = 0; i < this->hashes; ++i )
+    {
+        const quint64 bit = ( hash + i * step ) % bitCount;
+        data[bit / 64] |= 1ULL << ( bit % 64 );
+    }
+}
+
+bool BloomFilter::mightContain( const QChar *word, const int size ) const
+{
+    if( this->isNull() )
+    {
+        return true;
+    }
+
+    const quint64 hash = BloomFilter::hash( word, size );
+    const quint64 bitCount = static_cast<quint64>( this->words ) * 64;
+    const quint64 step = ( hash >> 32 ) | 1;
+
+    const quint64 *data = this->constData();
+
+    for( int i = 0; i < this->hashes; ++i )
+    {
+        const quint64 bit = ( hash + i * step ) % bitCount;
+
+        if( ( data[bit / 64] & ( 1ULL << ( bit % 64 ) ) ) == 0 )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool BloomFilter::mightContain( const QString &word ) const
+{
+    return this->mightContain( word.constData(), word.size() );
+}
+
+bool BloomFilter::isNull() const
+{
+    return this->words == 0;
+}
+
+const quint64 *BloomFilter::constData() const
+{
+    return ( this->rawWords != nullptr ) ? this->rawWords : this->bits.constData();
+}
+
+int BloomFilter::wordCount() const
+{
+    return this->words;
+}
+
+int BloomFilter::hashCount() const
+{
+    return this->hashes;
+}
+
+double BloomFilter::expectedFalsePositiveRate( const quint64 count ) const
+{
+    if( this->isNull() )
+    {
+        return 1.0;
+    }
+
+    const double bitCount = this->words * 64.0;
+
+    return std::pow( 1.0 - std::exp( -this->hashes * static_cast<double>( count ) / bitCount ), this->hashes );
+}
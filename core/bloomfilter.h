@@ -0,0 +1,62 @@
+#ifndef BLOOMFILTER_H
+#define BLOOMFILTER_H
+
+#include <QChar>
+#include <QString>
+#include <QVector>
+
+// lookups answered by a BloomFilter, see DictionaryFile::getFilterStatistics()
+struct BloomFilterStatistics
+{
+    // lookups the filter was asked for
+    quint64 lookups;
+    // words the filter knew to be missing, nothing else was read for them
+    quint64 rejected;
+    // words passing the filter without being found
+    quint64 falsePositives;
+    // false positive rate the filter was sized for, for the words it holds
+    double expectedFalsePositiveRate;
+};
+
+// Set of words without false negatives: a word the filter doesn't contain
+// definitely isn't part of the words it was built from.
+//
+// Every word sets hashCount bits chosen by double hashing of a 64-bit FNV-1a hash.
+// The bits are stored in 64-bit words, so a filter can be written to a file and
+// used from a mapping of it again, see fromRawData().
+class BloomFilter
+{
+public:
+    static quint64 hash( const QChar *word, const int size );
+
+    // an empty filter, it contains every word
+    BloomFilter();
+
+    // sized for count words at the given false positive rate
+    explicit BloomFilter( const int count, const double falsePositiveRate = 0.01 );
+
+    // uses the bits of another owner (e.g. a mapping) without copying, they have to outlive the filter
+    static BloomFilter fromRawData( const quint64 *words, const int wordCount, const int hashCount );
+
+    void insert( const QString &word );
+
+    bool mightContain( const QChar *word, const int size ) const;
+    bool mightContain( const QString &word ) const;
+
+    bool isNull() const;
+    const quint64 *constData() const;
+    int wordCount() const;
+    int hashCount() const;
+
+    // (1 - e^(-k*n/m))^k of a filter holding count words
+    double expectedFalsePositiveRate( const quint64 count ) const;
+
+private:
+    QVector<quint64> bits;
+    // bits or the words of fromRawData()
+    const quint64 *rawWords;
+    int words;
+    int hashes;
+};
+
+#endif // BLOOMFILTER_H
@@ -0,0 +1,23 @@
+# Links the static core library, include this from every project using it
+
+QT += core gui sql concurrent
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+# build directory of core, whatever directory the including project is in
+CORE_OUT_PWD = $$shadowed($$PWD)
+
+win32:CONFIG(release, debug|release) {
+    CORE_LIB_DIR = $$CORE_OUT_PWD/release
+} else:win32:CONFIG(debug, debug|release) {
+    CORE_LIB_DIR = $$CORE_OUT_PWD/debug
+} else {
+    CORE_LIB_DIR = $$CORE_OUT_PWD
+}
+
+LIBS += -L$$CORE_LIB_DIR -lcore
+
+win32-g++: PRE_TARGETDEPS += $$CORE_LIB_DIR/libcore.a
+else:win32:!win32-g++: PRE_TARGETDEPS += $$CORE_LIB_DIR/core.lib
+else: PRE_TARGETDEPS += $$CORE_LIB_DIR/libcore.a
@@ -0,0 +1,56 @@
+#-------------------------------------------------
+#
+# Analysis core of MyCuteThesaurus: words, database, logging,
+# tokenising, lookup and the render model.
+# Uses no widgets, so it can be linked by the app, benchmarks and
+# the headless batch mode alike. Link it by including core.pri
+#
+#-------------------------------------------------
+
+QT       += core gui sql concurrent
+
+TARGET = core
+TEMPLATE = lib
+CONFIG += staticlib
+
+# The following define makes your compiler emit warnings if you use
+# any feature of Qt which has been marked as deprecated (the exact warnings
+# depend on your compiler). Please consult the documentation of the
+# deprecated API in order to know how to port your code away from it.
+DEFINES += QT_DEPRECATED_WARNINGS
+
+CONFIG += c++11
+
+SOURCES += \
+    db_manager.cpp \
+    log.cpp \
+    tokenstore.cpp \
+    dictionaryindex.cpp \
+    textrenderer.cpp \
+    analysejob.cpp \
+    tokenizer.cpp \
+    textanalyser.cpp \
+    batchanalysis.cpp \
+    syntheticdata.cpp \
+    dictionaryfile.cpp \
+    translationcache.cpp \
+    bloomfilter.cpp \
+    stringinterner.cpp
+
+HEADERS += \
+    db_manager.h \
+    log.h \
+    tokenstore.h \
+    dictionaryindex.h \
+    textrenderer.h \
+    analysejob.h \
+    tokenizer.h \
+    textanalyser.h \
+    batchanalysis.h \
+    syntheticdata.h \
+    dictionaryfile.h \
+    translationcache.h \
+    bloomfilter.h \
+    stringinterner.h
+
+INCLUDEPATH += $$PWD
@@ -0,0 +1,1490 @@
+#include "db_manager.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSqlDriver>
+#include <QSqlError>
+#include <QSqlField>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QTextStream>
+
+#include <algorithm>
+
+#include "dictionaryfile.h"
+#include "log.h"
+
+namespace
+{
+    // schemaMigrations[i] upgrades a database from user_version i to i+1.
+    // Only ever append new steps here, never change released ones!
+    const QVector<QVector<QString>> schemaMigrations{
+        // 0 -> 1: indexes for word lookups and translations by from_word_id
+        {
+            "CREATE INDEX IF NOT EXISTS words_word_lang_id ON words(word, lang_id)",
+            "CREATE INDEX IF NOT EXISTS translations_from_word_id ON translations(from_word_id, to_word_id)"
+        },
+        // 1 -> 2: words are unique per language, needed by the upserts of importTranslations().
+        // Duplicates are merged into the oldest row first
+        {
+            "UPDATE OR IGNORE translations SET from_word_id = ( "
+                "SELECT MIN( duplicate.id ) FROM words AS word "
+                "JOIN words AS duplicate ON duplicate.word = word.word AND duplicate.lang_id = word.lang_id "
+                "WHERE word.id = translations.from_word_id )",
+            "UPDATE OR IGNORE translations SET to_word_id = ( "
+                "SELECT MIN( duplicate.id ) FROM words AS word "
+                "JOIN words AS duplicate ON duplicate.word = word.word AND duplicate.lang_id = word.lang_id "
+                "WHERE word.id = translations.to_word_id )",
+            "DELETE FROM translations "
+                "WHERE from_word_id NOT IN ( SELECT MIN( id ) FROM words GROUP BY word, lang_id ) "
+                "OR to_word_id NOT IN ( SELECT MIN( id ) FROM words GROUP BY word, lang_id )",
+            "DELETE FROM words WHERE id NOT IN ( SELECT MIN( id ) FROM words GROUP BY word, lang_id )",
+            "DROP INDEX IF EXISTS words_word_lang_id",
+            "CREATE UNIQUE INDEX IF NOT EXISTS words_word_lang_id ON words(word, lang_id)"
+        }
+    };
+
+    // unquotes a CSV field, "" inside of quotes is a single "
+    QString unquote( const QString &field )
+    {
+        const QString trimmed{ field.trimmed() };
+
+        if( trimmed.size() >= 2 && trimmed.startsWith( '"' ) && trimmed.endsWith( '"' ) )
+        {
+            return trimmed.mid( 1, trimmed.size() - 2 ).replace( "\"\"", "\"" ).trimmed();
+        }
+
+        return trimmed;
+    }
+
+    // splits a "foreign<TAB>native" or "foreign,native" line, further columns are ignored.
+    // Seperators inside of quotes don't split
+    QStringList splitColumns( const QString &line )
+    {
+        const QChar seperator{ line.contains( '\t' ) ? '\t' : ',' };
+
+        QStringList columns;
+        int columnStart = 0;
+        bool quoted = false;
+
+        for( int i = 0; i < line.size(); ++i )
+        {
+            if( line.at( i ) == '"' )
+            {
+                quoted = !quoted;
+            }
+            else if( line.at( i ) == seperator && !quoted )
+            {
+                columns.push_back( unquote( line.mid( columnStart, i - columnStart ) ) );
+                columnStart = i + 1;
+            }
+        }
+
+        columns.push_back( unquote( line.mid( columnStart ) ) );
+
+        return columns;
+    }
+}
+
+DB_Manager::DB_Manager( QObject *parent, const QString &dbName, const QString &connectionName )
+: QObject{ parent }
+, dbName{ dbName }
+, connectionName{ connectionName }
+, statementCacheEnabled{ true }
+{
+    this->db = QSqlDatabase::addDatabase( "QSQLITE", connectionName );
+    //this->db.setHostName("test.domain.de");
+    this->db.setDatabaseName( dbName );
+    //this->db.setUserName("");
+    //this->db.setPassword("");
+
+    if( !this->db.open() )
+    {
+        ::logError( "Connection with database failed" );
+    }
+    else
+    {
+        qDebug() << "Database connected";
+    }
+
+    if( !this->isOk() )
+    {
+        ::logError( "Missing tables in database" );
+    }
+    else
+    {
+        qDebug() << "All tables found. DB is ok.";
+
+        this->migrate();
+    }
+}
+
+DB_Manager::~DB_Manager()
+{
+    // prepared statements have to be released before the connection is closed
+    this->preparedQueries.clear();
+    this->uncachedQuery = QSqlQuery{};
+
+    if( this->db.open() )
+    {
+        this->db.close();
+        qDebug() << "Database disconnected";
+    }
+
+    // removeDatabase() requires that no handle to the connection is left
+    this->db = QSqlDatabase{};
+    QSqlDatabase::removeDatabase( this->connectionName );
+}
+
+/*
+std::shared_ptr<DB_Model_FollowerCountHistory> DB_Manager::getLastFollowerCountHistory() const
+{
+    QSqlQuery query( this->db );
+
+    query.prepare( "SELECT max(id),* FROM follower_count_history" );
+
+    if( query.exec() )
+    {
+        if( query.first() && !query.isNull("created_at") && !query.isNull("created_at") )
+        {
+            const QString created_at = query.value( "created_at" ).toString();
+            const int follower_count = query.value( "follower_count" ).toInt();
+
+            return std::shared_ptr<DB_Model_FollowerCountHistory>{ new DB_Model_FollowerCountHistory{ created_at, follower_count } };
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+    else
+    {
+        qDebug() << "SqLite error:" << query.lastError().text();
+    }
+
+    return nullptr;
+}
+
+QMultiMap<int,std::shared_ptr<DB_Model_UserName>> DB_Manager::getUserNames() const
+{
+    QMultiMap<int,std::shared_ptr<DB_Model_UserName>> userNames;
+
+    QSqlQuery query( this->db );
+
+    query.prepare( "SELECT * FROM twitch_user_name_history" );
+
+    if( query.exec() )
+    {
+        while( query.next() )
+        {
+            userNames.insert( query.value( "user_id" ).toInt(),
+                              std::shared_ptr<DB_Model_UserName>(
+                                  new DB_Model_UserName{ query.value( "user_id" ).toInt(),
+                                            query.value( "name" ).toString(),
+                                            query.value( "created_at" ).toString() } )
+                              );
+        }
+    }
+    else
+    {
+        qDebug() << "SqLite error:" << query.lastError().text();
+    }
+
+    return userNames;
+}
+
+QMultiMap<int,std::shared_ptr<DB_Model_DisplayName>> DB_Manager::getDisplayNames() const
+{
+    QMultiMap<int,std::shared_ptr<DB_Model_DisplayName>> displayNames;
+
+    QSqlQuery query( this->db );
+
+    query.prepare( "SELECT * FROM twitch_user_displayname_history" );
+
+    if( query.exec() )
+    {
+        while( query.next() )
+        {
+            displayNames.insert( query.value( "user_id" ).toInt(),
+                                 std::shared_ptr<DB_Model_DisplayName>(
+                                     new DB_Model_DisplayName{ query.value( "user_id" ).toInt(),
+                                        query.value( "displayname" ).toString(),
+                                        query.value( "created_at" ).toString() } )
+                                 );
+        }
+    }
+    else
+    {
+        qDebug() << "SqLite error:" << query.lastError().text();
+    }
+
+    return displayNames;
+}
+
+QString DB_Manager::getDisplayName(const int &user_id) const
+{
+    QSqlQuery query( this->db );
+
+    query.prepare( "SELECT max(id),* FROM twitch_user_displayname_history WHERE user_id = "
+                  + QString::number( user_id ) );
+
+    if( query.exec() )
+    {
+        if( query.next() && !query.isNull( "display_name" ) )
+        {
+            return query.value( "display_name" ).toString();
+        }
+    }
+    else
+    {
+        qDebug() << "SqLite error:" << query.lastError().text();
+    }
+
+    return "";
+}
+
+QString DB_Manager::getName( const int &user_id ) const
+{
+    QSqlQuery query( this->db );
+
+    query.prepare( "SELECT max(id),* FROM twitch_user_name_history WHERE user_id = "
+                  + QString::number( user_id ) );
+
+    if( query.exec() )
+    {
+        if( query.next() && !query.isNull( "name" ) )
+        {
+            return query.value( "name" ).toString();
+        }
+    }
+    else
+    {
+        qDebug() << "SqLite error:" << query.lastError().text();
+    }
+
+    return "";
+}
+
+QMultiMap<int,std::shared_ptr<DB_Model_FollowHistory>> DB_Manager::getFollowHistory( const HistoryFollowerFlag &historyFollowerFlag ) const
+{
+    QMultiMap<int,std::shared_ptr<DB_Model_FollowHistory>> followHistory;
+
+    QSqlQuery query( this->db );
+
+    QString whereString;
+
+    switch( historyFollowerFlag )
+    {
+        case HistoryFollowerFlag::ALL_FOLLOWS:
+            whereString = " WHERE is_follower == 1";
+            break;
+
+        case HistoryFollowerFlag::ALL_DEFOLLOWS:
+            whereString = " WHERE is_follower == 0";
+            break;
+    }
+
+    query.prepare( "SELECT * FROM follow_history" + whereString );
+
+    if( query.exec() )
+    {
+        while( query.next() )
+        {
+            followHistory.insert( query.value( "user_id" ).toInt(),
+                                  std::shared_ptr<DB_Model_FollowHistory>(
+                                        new DB_Model_FollowHistory{ query.value( "user_id" ).toInt(),
+                                            query.value( "is_follower" ).toInt(),
+                                            query.value( "created_at" ).toString() }
+                                      ) );
+        }
+    }
+    else
+    {
+        qDebug() << "SqLite error:" << query.lastError().text();
+    }
+
+    return followHistory;
+}
+
+QMap<int,TwitchUser*> DB_Manager::getTwitchUsers() const
+{
+    QMap<int,TwitchUser*> twitchUser;
+
+    QSqlQuery query( this->db );
+
+    query.prepare( "SELECT * FROM twitch_user" );
+
+    if( query.exec() )
+    {
+        while( query.next() )
+        {
+            const int user_id = query.value( "user_id" ).toInt();
+            const QString name = this->getName( user_id );
+            const QString displayname = this->getDisplayName( user_id );
+
+            twitchUser.insert( user_id,
+                       new TwitchUser{ this->parent(),
+                                     query.value( "user_id" ).toInt(),
+                                     name,
+                                     displayname,
+                                     query.value( "last_update" ).toString(),
+                                     query.value( "created_at" ).toString(),
+                                     query.value( "updated_at" ).toString(),
+                                     query.value( "bio" ).toString(),
+                                     query.value( "logo" ).toString(),
+                                     query.value( "type" ).toString(),
+                                     query.value( "notifications" ).toInt() } );
+        }
+    }
+    else
+    {
+        qDebug() << "SqLite error:" << query.lastError().text();
+    }
+
+    return twitchUser;
+}
+
+std::shared_ptr<TwitchUser> DB_Manager::getTwitchUser(const int &user_id) const
+{
+    QSqlQuery query( this->db );
+
+    query.prepare( "SELECT * FROM twitch_user WHERE user_id = " + QString::number( user_id ) );
+
+    if( query.exec() )
+    {
+        if( query.next() )
+        {
+            const QString name = this->getName( user_id );
+            const QString displayname = this->getDisplayName( user_id );
+
+            return std::shared_ptr<TwitchUser>( new TwitchUser{ this->parent(),
+                                     query.value( "user_id" ).toInt(),
+                                     name,
+                                     displayname,
+                                     query.value( "last_update" ).toString(),
+                                     query.value( "created_at" ).toString(),
+                                     query.value( "updated_at" ).toString(),
+                                     query.value( "bio" ).toString(),
+                                     query.value( "logo" ).toString(),
+                                     query.value( "type" ).toString(),
+                                     query.value( "notifications" ).toInt() } );
+        }
+    }
+    else
+    {
+        qDebug() << "SqLite error:" << query.lastError().text();
+    }
+
+    return nullptr;
+}
+
+void DB_Manager::addFollowerCountHistory( const QString &created_at, const int &follower_count )
+{
+    QSqlQuery query( this->db );
+
+    query.prepare( "INSERT INTO follower_count_history(created_at, follower_count) "
+                   "VALUES(:created_at, :follower_count )" );
+
+    query.bindValue( ":created_at", created_at );
+    query.bindValue( ":follower_count", follower_count );
+
+    if( !query.exec() )
+    {
+        qDebug() << "SqLite error:" << query.lastError().text();
+    }
+}
+
+void DB_Manager::addUserName( const int &user_id, const QString &username, const QString &created_at ) const
+{
+    QSqlQuery query( this->db );
+
+    query.prepare( "INSERT INTO twitch_user_name_history(user_id,name,created_at) "
+                   "VALUES(:user_id,:name,:created_at)" );
+
+    query.bindValue( ":user_id", user_id );
+    query.bindValue( ":name", username );
+    query.bindValue( ":created_at", created_at );
+
+    if( !query.exec() )
+    {
+        qDebug() << "SqLite error:" << query.lastError().text();
+    }
+}
+
+*/
+
+bool DB_Manager::isOk() const
+{
+    if( this->tableExists( "settings" ) &&
+        this->tableExists( "languages" ) &&
+        this->tableExists( "words" ) &&
+        this->tableExists( "translations" ) )
+    {
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+int DB_Manager::schemaVersion() const
+{
+    QSqlQuery query( this->db );
+
+    if( query.exec( "PRAGMA user_version" ) )
+    {
+        if( query.next() )
+        {
+            return query.value( 0 ).toInt();
+        }
+
+        return 0;
+    }
+    else
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+}
+
+QVector<QString> DB_Manager::getLanguages() const
+{
+    QVector<QString> langs;
+
+    QSqlQuery &query = this->preparedQuery( "SELECT * FROM languages" );
+
+    if( query.exec() )
+    {
+        while( query.next() )
+        {
+            const QString lang = query.value( "lang" ).toString();
+            langs.push_back( lang );
+        }
+
+        query.finish();
+    }
+    else
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+
+    return langs;
+}
+
+int DB_Manager::getLangId( const QString &langTag ) const
+{
+    int langId = 0;
+
+    QSqlQuery &query = this->preparedQuery( "SELECT * FROM languages WHERE lang = :langTag" );
+    query.bindValue( ":langTag", langTag );
+
+    if( query.exec() )
+    {
+        if( query.next() )
+        {
+            langId = query.value( "id" ).toInt();
+        }
+
+        query.finish();
+    }
+    else
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+
+    return langId;
+}
+
+QString DB_Manager::getLangTag( const int &lang_id ) const
+{
+    QString langTag;
+
+    QSqlQuery &query = this->preparedQuery( "SELECT lang FROM languages WHERE id = :lang_id" );
+    query.bindValue( ":lang_id", lang_id );
+
+    if( query.exec() )
+    {
+        if( query.next() )
+        {
+            langTag = query.value( "lang" ).toString();
+        }
+
+        query.finish();
+    }
+    else
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+
+    return langTag;
+}
+
+int DB_Manager::getWordId( const QString &word, const int &lang_id ) const
+{
+    QSqlQuery &query = this->preparedQuery( "SELECT * FROM words WHERE word = :word AND lang_id = :lang_id" );
+
+    query.bindValue( ":word", word );
+    query.bindValue( ":lang_id", lang_id );
+
+    if( query.exec() )
+    {
+        if( query.next() )
+        {
+            const int id = query.value( "id" ).toInt();
+            query.finish();
+
+            return id;
+        }
+
+        throw "Could not be! There is no current language set in table settings!!!";
+    }
+    else
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+}
+
+QString DB_Manager::getWord( const int word_id ) const
+{
+    QSqlQuery &query = this->preparedQuery( "SELECT word FROM words WHERE id = :word_id" );
+
+    query.bindValue( ":word_id", word_id );
+
+    if( query.exec() )
+    {
+        if( query.next() )
+        {
+            const QString word = query.value( "word" ).toString();
+            query.finish();
+
+            return word;
+        }
+
+        throw "Could not be! There is no current language set in table settings!!!";
+    }
+    else
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+}
+
+bool DB_Manager::isTranslatedWord( const QString &word, const int &lang_id ) const
+{
+    if( !this->isKnownWord( word, lang_id ) )
+    {
+        return false;
+    }
+    else
+    {
+        const int word_id = this->getWordId( word, lang_id );
+        const int native_lang_id = this->getLangId( this->getCurrentNativeLang() );
+
+        QSqlQuery &query = this->preparedQuery(
+                    "SELECT * FROM words,translations WHERE translations.from_word_id = :word_id "
+                    "and translations.to_word_id=words.id and words.lang_id = :native_lang_id" );
+
+        query.bindValue( ":word_id", word_id );
+        query.bindValue( ":native_lang_id", native_lang_id );
+
+        if( query.exec() )
+        {
+            const bool translated = query.next();
+            query.finish();
+
+            return translated;
+        }
+        else
+        {
+            ::logError( "SqLite error:" + query.lastError().text() );
+            throw "SqLite error:" + query.lastError().text();
+        }
+    }
+}
+
+bool DB_Manager::isKnownWord( const QString &word, const int &lang_id ) const
+{
+    //const int wordId{ this->getWordId( word ) };
+    //const int nativeLangId = this->getLangId( this->getCurrentNativeLang() );
+
+    QSqlQuery &query = this->preparedQuery( "SELECT id FROM words WHERE word = :word AND lang_id = :lang_id" );
+
+    query.bindValue( ":word", word );
+    query.bindValue( ":lang_id", lang_id );
+
+    if( query.exec() )
+    {
+        const bool known = query.next();
+        query.finish();
+
+        return known;
+    }
+    else
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+}
+
+QString DB_Manager::getCurrentNativeLang() const
+{
+    QSqlQuery &query = this->preparedQuery( "select lang from settings,languages WHERE settings.key = 'NativeLanguageID' AND settings.value = languages.id" );
+
+    if( query.exec() )
+    {
+        if( query.next() )
+        {
+            const QString langTag{ query.value( "lang" ).toString() };
+            query.finish();
+
+            if( !langTag.isEmpty() )
+            {
+                return langTag;
+            }
+        }
+
+        throw "Could not be! There is no current language set in table settings!!!";
+    }
+    else
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+}
+
+QString DB_Manager::getCurrentForeignLang() const
+{
+    QSqlQuery &query = this->preparedQuery( "select lang from settings,languages WHERE settings.key = 'ForeignLanguageID' AND settings.value = languages.id" );
+
+    if( query.exec() )
+    {
+        if( query.next() )
+        {
+            const QString langTag{ query.value( "lang" ).toString() };
+            query.finish();
+
+            if( !langTag.isEmpty() )
+            {
+                return langTag;
+            }
+        }
+
+        throw "Could not be! There is no current language set in table settings!!!";
+    }
+    else
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+}
+
+void DB_Manager::updateCurrentNativeLang( const QString &nativeLang ) const
+{
+    const int langId = this->getLangId( nativeLang.toLower() );
+
+    QSqlQuery &query = this->preparedQuery( "UPDATE settings SET value = :nativeLanguageID WHERE key = 'NativeLanguageID'" );
+
+    query.bindValue( ":nativeLanguageID", langId );
+
+    if( !query.exec() )
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+}
+
+void DB_Manager::updateCurrentForeignLang( const QString &foreignLang ) const
+{
+    const int langId = this->getLangId( foreignLang.toLower() );
+
+    QSqlQuery &query = this->preparedQuery( "UPDATE settings SET value = :foreignLang WHERE key = 'ForeignLanguageID'" );
+
+    query.bindValue( ":foreignLang", langId );
+
+    if( !query.exec() )
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+}
+
+qint64 DB_Manager::getSetting( const QString &key, const qint64 defaultValue ) const
+{
+    QSqlQuery &query = this->preparedQuery( "SELECT value FROM settings WHERE key = :key" );
+
+    query.bindValue( ":key", key );
+
+    if( query.exec() )
+    {
+        qint64 value{ defaultValue };
+
+        if( query.next() )
+        {
+            value = query.value( "value" ).toLongLong();
+        }
+
+        query.finish();
+
+        return value;
+    }
+    else
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+}
+
+qint64 DB_Manager::getDictionaryGeneration() const
+{
+    return this->getSetting( "DictionaryGeneration", 0 );
+}
+
+void DB_Manager::nextDictionaryGeneration() const
+{
+    QSqlQuery &query = this->preparedQuery( "INSERT INTO settings(key,value) VALUES('DictionaryGeneration',1) "
+                                            "ON CONFLICT(key) DO UPDATE SET value = value + 1" );
+
+    if( !query.exec() )
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+}
+
+void DB_Manager::insertNewWord( const QString &word, const int &lang_id ) const
+{
+    QSqlQuery &query = this->preparedQuery( "INSERT INTO words(word,lang_id)"
+                                            "VALUES(:word,:lang_id)" );
+
+    query.bindValue( ":word", word );
+    query.bindValue( ":lang_id", lang_id );
+
+    if( !query.exec() )
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+}
+
+void DB_Manager::translate( const QString &nativeWord, const int &nativeLangId,
+                            const QString &foreignWord, const int &foreignLangId ) const
+{
+    if( !this->isKnownWord( nativeWord, nativeLangId ) )
+    {
+        this->insertNewWord( nativeWord, nativeLangId );
+    }
+
+    if( !this->isKnownWord( foreignWord, foreignLangId ) )
+    {
+        this->insertNewWord( foreignWord, foreignLangId );
+    }
+
+    const int from_word_id = this->getWordId( nativeWord, nativeLangId );
+    const int to_word_id = this->getWordId( foreignWord, foreignLangId );
+
+    QSqlQuery &query = this->preparedQuery( "INSERT INTO translations(from_word_id,to_word_id)"
+                                            "VALUES(:from_word_id,:to_word_id)" );
+
+    query.bindValue( ":from_word_id", from_word_id );
+    query.bindValue( ":to_word_id", to_word_id );
+
+    if( !query.exec() )
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+
+    this->nextDictionaryGeneration();
+}
+
+ImportStatistics DB_Manager::importTranslations( const QString &fileName, const int &foreignLangId,
+                                                const int &nativeLangId ) const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file{ fileName };
+
+    if( !file.open( QFile::ReadOnly | QFile::Text ) )
+    {
+        ::logError( "Could not open " + fileName + ": " + file.errorString() );
+        throw "Could not open " + fileName + ": " + file.errorString();
+    }
+
+    QTextStream stream{ &file };
+    stream.setCodec( "UTF-8" );
+
+    ImportStatistics statistics{ 0, 0, 0, 0 };
+
+    // ids of the words of this import, most words of a word list appear more than once
+    QHash<QString, int> foreignWordIds;
+    QHash<QString, int> nativeWordIds;
+
+    QSqlDatabase connection{ this->db };
+    connection.transaction();
+
+    try
+    {
+        while( !stream.atEnd() )
+        {
+            const QString line{ stream.readLine() };
+            ++statistics.lines;
+
+            if( line.trimmed().isEmpty() || line.trimmed().startsWith( '#' ) )
+            {
+                continue;
+            }
+
+            const QStringList columns{ splitColumns( line ) };
+
+            if( columns.size() < 2 || columns.at( 0 ).isEmpty() || columns.at( 1 ).isEmpty() )
+            {
+                ++statistics.skippedLines;
+                continue;
+            }
+
+            const int foreignWordId = this->upsertWord( columns.at( 0 ), foreignLangId, foreignWordIds );
+            const int nativeWordId = this->upsertWord( columns.at( 1 ), nativeLangId, nativeWordIds );
+
+            // both directions, like TranslationDialog does
+            this->upsertTranslation( foreignWordId, nativeWordId );
+            this->upsertTranslation( nativeWordId, foreignWordId );
+
+            ++statistics.pairs;
+        }
+
+        this->nextDictionaryGeneration();
+
+        if( !connection.commit() )
+        {
+            ::logError( "SqLite error:" + connection.lastError().text() );
+            throw "SqLite error:" + connection.lastError().text();
+        }
+    }
+    catch( ... )
+    {
+        connection.rollback();
+        throw;
+    }
+
+    statistics.milliseconds = timer.elapsed();
+
+    ::logInfo( QString{ "Imported %1 translations from %2 in %3 ms" }
+               .arg( statistics.pairs ).arg( fileName ).arg( statistics.milliseconds ) );
+
+    return statistics;
+}
+
+int DB_Manager::exportDictionary( const QString &fileName, const int &foreign_lang_id,
+                                  const int &native_lang_id ) const
+{
+    // commits after this point make the file outdated, see isDictionaryFileCurrent()
+    const qint64 generation{ this->getDictionaryGeneration() };
+
+    DictionaryFileWriter writer{ fileName };
+
+    if( !writer.open( this->getLangTag( foreign_lang_id ), this->getLangTag( native_lang_id ), generation ) )
+    {
+        ::logError( "Could not write " + fileName + ": " + writer.errorString() );
+        throw "Could not write " + fileName + ": " + writer.errorString();
+    }
+
+    // not cached: a forward only query hands out row by row instead of caching the whole result
+    QSqlQuery query( this->db );
+    query.setForwardOnly( true );
+
+    query.prepare( "SELECT foreign_word.id, foreign_word.word, native.id, native.word "
+                   "FROM words AS foreign_word "
+                   "JOIN translations ON translations.from_word_id = foreign_word.id "
+                   "JOIN words AS native ON native.id = translations.to_word_id "
+                   "WHERE foreign_word.lang_id = :foreign_lang_id AND native.lang_id = :native_lang_id "
+                   "ORDER BY foreign_word.word, foreign_word.id, translations.rowid" );
+
+    query.bindValue( ":foreign_lang_id", foreign_lang_id );
+    query.bindValue( ":native_lang_id", native_lang_id );
+
+    if( !query.exec() )
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+
+    int entries = 0;
+    int lastForeignWordId = -1;
+
+    while( query.next() )
+    {
+        const QString nativeWord{ query.value( 3 ).toString() };
+
+        if( nativeWord.isEmpty() )
+        {
+            continue;
+        }
+
+        const int foreignWordId = query.value( 0 ).toInt();
+
+        if( foreignWordId != lastForeignWordId )
+        {
+            lastForeignWordId = foreignWordId;
+            ++entries;
+        }
+
+        writer.addTranslation( foreignWordId, query.value( 1 ).toString(), query.value( 2 ).toInt(), nativeWord );
+    }
+
+    query.finish();
+
+    if( !writer.commit() )
+    {
+        ::logError( "Could not write " + fileName + ": " + writer.errorString() );
+        throw "Could not write " + fileName + ": " + writer.errorString();
+    }
+
+    ::logInfo( QString{ "Exported %1 words to %2" }.arg( entries ).arg( fileName ) );
+
+    return entries;
+}
+
+ImportStatistics DB_Manager::importDictionary( const QString &fileName ) const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    DictionaryFile dictionary;
+
+    if( !dictionary.open( fileName ) )
+    {
+        ::logError( "Could not open " + fileName + ": " + dictionary.errorString() );
+        throw "Could not open " + fileName + ": " + dictionary.errorString();
+    }
+
+    const int foreignLangId = this->getLangId( dictionary.getForeignLang() );
+    const int nativeLangId = this->getLangId( dictionary.getNativeLang() );
+
+    if( foreignLangId == 0 || nativeLangId == 0 )
+    {
+        ::logError( "Unknown language in " + fileName );
+        throw "Unknown language in " + fileName;
+    }
+
+    ImportStatistics statistics{ 0, 0, 0, 0 };
+
+    QHash<QString, int> foreignWordIds;
+    QHash<QString, int> nativeWordIds;
+
+    QSqlDatabase connection{ this->db };
+    connection.transaction();
+
+    try
+    {
+        for( int entryId = 0; entryId < dictionary.size(); ++entryId )
+        {
+            // deep copies, bound values of the cached statements outlive the mapping
+            const QString foreignWord{ dictionary.entryWord( entryId ) };
+            const int foreignWordId = this->upsertWord( QString{ foreignWord.constData(), foreignWord.size() },
+                                                        foreignLangId, foreignWordIds );
+
+            for( const QString &translation : dictionary.entryTranslations( entryId ) )
+            {
+                const int nativeWordId = this->upsertWord( QString{ translation.constData(), translation.size() },
+                                                           nativeLangId, nativeWordIds );
+
+                this->upsertTranslation( foreignWordId, nativeWordId );
+                this->upsertTranslation( nativeWordId, foreignWordId );
+
+                ++statistics.pairs;
+            }
+        }
+
+        this->nextDictionaryGeneration();
+
+        if( !connection.commit() )
+        {
+            ::logError( "SqLite error:" + connection.lastError().text() );
+            throw "SqLite error:" + connection.lastError().text();
+        }
+    }
+    catch( ... )
+    {
+        connection.rollback();
+        throw;
+    }
+
+    statistics.lines = dictionary.size();
+    statistics.milliseconds = timer.elapsed();
+
+    ::logInfo( QString{ "Imported %1 translations from %2 in %3 ms" }
+               .arg( statistics.pairs ).arg( fileName ).arg( statistics.milliseconds ) );
+
+    return statistics;
+}
+
+// e.g. mycutethesaurus.en-de.42.mctd
+QString DB_Manager::getDictionaryFileName( const int &foreign_lang_id, const int &native_lang_id ) const
+{
+    return this->languagePairFileName( foreign_lang_id, native_lang_id,
+                                       QString{ "%1.mctd" }.arg( this->getDictionaryGeneration() ) );
+}
+
+void DB_Manager::removeOutdatedDictionaryFiles( const int &foreign_lang_id, const int &native_lang_id,
+                                                const QString &keepFileName ) const
+{
+    const QFileInfo pattern{ this->languagePairFileName( foreign_lang_id, native_lang_id, "*.mctd" ) };
+    // the single file of older versions had no generation
+    const QFileInfo unversioned{ this->languagePairFileName( foreign_lang_id, native_lang_id, "mctd" ) };
+    const QFileInfo keep{ keepFileName };
+
+    const QStringList nameFilters{ pattern.fileName(), unversioned.fileName() };
+
+    for( const QFileInfo &dictionary : pattern.dir().entryInfoList( nameFilters, QDir::Files ) )
+    {
+        if( dictionary.fileName() != keep.fileName() && !QFile::remove( dictionary.filePath() ) )
+        {
+            ::logInfo( "Outdated dictionary file " + dictionary.filePath() + " is still in use" );
+        }
+    }
+}
+
+QString DB_Manager::getTranslationCacheFileName( const int &foreign_lang_id, const int &native_lang_id ) const
+{
+    return this->languagePairFileName( foreign_lang_id, native_lang_id, "cache" );
+}
+
+// e.g. mycutethesaurus.en-de.mctd next to mycutethesaurus.db
+QString DB_Manager::languagePairFileName( const int &foreign_lang_id, const int &native_lang_id,
+                                          const QString &suffix ) const
+{
+    const QFileInfo database{ this->dbName };
+
+    return database.dir().filePath( QString{ "%1.%2-%3.%4" }
+                                    .arg( database.completeBaseName() )
+                                    .arg( this->getLangTag( foreign_lang_id ) )
+                                    .arg( this->getLangTag( native_lang_id ) )
+                                    .arg( suffix ) );
+}
+
+bool DB_Manager::isDictionaryFileCurrent( const QString &fileName ) const
+{
+    DictionaryFile dictionary;
+
+    // every commit of words or translations increments the generation, the header
+    // holds the one exportDictionary() started with
+    return dictionary.open( fileName, false ) &&
+           dictionary.getGeneration() == this->getDictionaryGeneration();
+}
+
+QVector<QString> DB_Manager::getTanslations( const QString &from_word, const int &foreign_lang_id,
+                                             const int &native_lang_id ) const
+{
+    QSqlQuery &query = this->preparedQuery(
+                "SELECT native.word FROM words AS foreign_word "
+                "JOIN translations ON translations.from_word_id = foreign_word.id "
+                "JOIN words AS native ON native.id = translations.to_word_id "
+                "WHERE foreign_word.word = :from_word AND foreign_word.lang_id = :foreign_lang_id "
+                "AND native.lang_id = :native_lang_id "
+                "ORDER BY translations.rowid" );
+
+    query.bindValue( ":from_word", from_word );
+    query.bindValue( ":foreign_lang_id", foreign_lang_id );
+    query.bindValue( ":native_lang_id", native_lang_id );
+
+    if( query.exec() )
+    {
+        QVector<QString> transations;
+
+        while( query.next() )
+        {
+            const QString word = query.value( "word" ).toString();
+
+            if( !word.isEmpty() )
+            {
+                transations.push_back( word );
+            }
+        }
+
+        query.finish();
+
+        return transations;
+    }
+    else
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+}
+
+QHash<QString, QVector<QString>> DB_Manager::getTranslationsBatch( const QVector<QString> &from_words,
+                                                                   const int &foreign_lang_id,
+                                                                   const int &native_lang_id ) const
+{
+    // SQLite allows 999 host parameters per statement by default
+    const int chunkSize = 500;
+
+    QHash<QString, QVector<QString>> translations;
+
+    if( from_words.isEmpty() )
+    {
+        return translations;
+    }
+
+    // every chunk uses the same amount of placeholders (the last one is padded
+    // with duplicates), so only one statement has to be prepared and cached
+    QString placeholders;
+    placeholders.reserve( chunkSize * 2 );
+
+    for( int i = 0; i < chunkSize; ++i )
+    {
+        placeholders.append( ( i == 0 ) ? "?" : ",?" );
+    }
+
+    QSqlQuery &query = this->preparedQuery(
+                "SELECT foreign_word.word AS from_word, native.word AS to_word "
+                "FROM words AS foreign_word "
+                "JOIN translations ON translations.from_word_id = foreign_word.id "
+                "JOIN words AS native ON native.id = translations.to_word_id "
+                "WHERE foreign_word.lang_id = ? AND native.lang_id = ? "
+                "AND foreign_word.word IN (" + placeholders + ") "
+                "ORDER BY translations.rowid" );
+
+    for( int chunkStart = 0; chunkStart < from_words.size(); chunkStart += chunkSize )
+    {
+        const int count = std::min( chunkSize, from_words.size() - chunkStart );
+
+        query.bindValue( 0, foreign_lang_id );
+        query.bindValue( 1, native_lang_id );
+
+        for( int i = 0; i < chunkSize; ++i )
+        {
+            query.bindValue( i + 2, from_words.at( chunkStart + std::min( i, count - 1 ) ) );
+        }
+
+        if( !query.exec() )
+        {
+            ::logError( "SqLite error:" + query.lastError().text() );
+            throw "SqLite error:" + query.lastError().text();
+        }
+
+        while( query.next() )
+        {
+            const QString word = query.value( "to_word" ).toString();
+
+            if( !word.isEmpty() )
+            {
+                translations[query.value( "from_word" ).toString()].push_back( word );
+            }
+        }
+
+        query.finish();
+    }
+
+    return translations;
+}
+
+QVector<QPair<QString, QString>> DB_Manager::getAllTranslations( const int &foreign_lang_id,
+                                                                 const int &native_lang_id ) const
+{
+    QSqlQuery &query = this->preparedQuery(
+                "SELECT foreign_word.word AS from_word, native.word AS to_word "
+                "FROM words AS foreign_word "
+                "JOIN translations ON translations.from_word_id = foreign_word.id "
+                "JOIN words AS native ON native.id = translations.to_word_id "
+                "WHERE foreign_word.lang_id = :foreign_lang_id AND native.lang_id = :native_lang_id "
+                "ORDER BY foreign_word.id, translations.rowid" );
+
+    query.bindValue( ":foreign_lang_id", foreign_lang_id );
+    query.bindValue( ":native_lang_id", native_lang_id );
+
+    if( query.exec() )
+    {
+        QVector<QPair<QString, QString>> translations;
+
+        while( query.next() )
+        {
+            const QString word = query.value( 1 ).toString();
+
+            if( !word.isEmpty() )
+            {
+                translations.push_back( qMakePair( query.value( 0 ).toString(), word ) );
+            }
+        }
+
+        query.finish();
+
+        return translations;
+    }
+    else
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+}
+
+int DB_Manager::update( const int wordID, const QString &word ) const
+{
+    QSqlQuery &langQuery = this->preparedQuery( "SELECT lang_id FROM words WHERE id = :id" );
+
+    langQuery.bindValue( ":id", wordID );
+
+    if( !langQuery.exec() )
+    {
+        ::logError( "SqLite error:" + langQuery.lastError().text() );
+        throw "SqLite error:" + langQuery.lastError().text();
+    }
+
+    if( !langQuery.next() )
+    {
+        ::logError( QString{ "Unknown word id %1" }.arg( wordID ) );
+        throw QString{ "Unknown word id %1" }.arg( wordID );
+    }
+
+    const int lang_id = langQuery.value( 0 ).toInt();
+    langQuery.finish();
+
+    // words are unique per language, a word renamed to a known one is merged into it
+    const int id = this->isKnownWord( word, lang_id ) ? this->getWordId( word, lang_id ) : wordID;
+
+    QSqlDatabase connection{ this->db };
+    connection.transaction();
+
+    try
+    {
+        if( id == wordID )
+        {
+            QSqlQuery &query = this->preparedQuery( "UPDATE words SET word = :word WHERE id = :id" );
+
+            query.bindValue( ":word", word );
+            query.bindValue( ":id", wordID );
+
+            if( !query.exec() )
+            {
+                ::logError( "SqLite error:" + query.lastError().text() );
+                throw "SqLite error:" + query.lastError().text();
+            }
+        }
+        else
+        {
+            this->mergeWord( wordID, id );
+        }
+
+        this->nextDictionaryGeneration();
+
+        if( !connection.commit() )
+        {
+            ::logError( "SqLite error:" + connection.lastError().text() );
+            throw "SqLite error:" + connection.lastError().text();
+        }
+    }
+    catch( ... )
+    {
+        connection.rollback();
+        throw;
+    }
+
+    return id;
+}
+
+void DB_Manager::remove( const int wordID ) const
+{
+    QSqlQuery &query = this->preparedQuery( "DELETE FROM words WHERE id = :id" );
+
+    query.bindValue( ":id", wordID );
+
+    if( !query.exec() )
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+
+    QSqlQuery &query2 = this->preparedQuery( "DELETE FROM translations WHERE from_word_id = :from_word_id OR to_word_id = :to_word_id" );
+
+    query2.bindValue( ":from_word_id", wordID );
+    query2.bindValue( ":to_word_id", wordID );
+
+    if( !query2.exec() )
+    {
+        ::logError( "SqLite error:" + query2.lastError().text() );
+        throw "SqLite error:" + query2.lastError().text();
+    }
+
+    this->nextDictionaryGeneration();
+}
+
+// returns the id of word, inserting it if it is new
+int DB_Manager::upsertWord( const QString &word, const int &lang_id, QHash<QString, int> &wordIds ) const
+{
+    auto wordId = wordIds.find( word );
+
+    if( wordId != wordIds.end() )
+    {
+        return wordId.value();
+    }
+
+    QSqlQuery &query = this->preparedQuery( "INSERT INTO words(word,lang_id) VALUES(:word,:lang_id) "
+                                            "ON CONFLICT(word,lang_id) DO NOTHING" );
+
+    query.bindValue( ":word", word );
+    query.bindValue( ":lang_id", lang_id );
+
+    if( !query.exec() )
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+
+    // an already known word wasn't inserted, its id has to be looked up
+    const int id = ( query.numRowsAffected() == 1 ) ? query.lastInsertId().toInt()
+                                                    : this->getWordId( word, lang_id );
+
+    wordIds.insert( word, id );
+
+    return id;
+}
+
+void DB_Manager::upsertTranslation( const int from_word_id, const int to_word_id ) const
+{
+    QSqlQuery &query = this->preparedQuery( "INSERT INTO translations(from_word_id,to_word_id) "
+                                            "VALUES(:from_word_id,:to_word_id) ON CONFLICT DO NOTHING" );
+
+    query.bindValue( ":from_word_id", from_word_id );
+    query.bindValue( ":to_word_id", to_word_id );
+
+    if( !query.exec() )
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+}
+
+// moves the translations of wordID to intoWordID and removes wordID. Translations
+// both words have are kept once
+void DB_Manager::mergeWord( const int wordID, const int intoWordID ) const
+{
+    QSqlQuery &fromQuery = this->preparedQuery( "UPDATE OR IGNORE translations SET from_word_id = :into_word_id "
+                                                "WHERE from_word_id = :word_id" );
+
+    fromQuery.bindValue( ":into_word_id", intoWordID );
+    fromQuery.bindValue( ":word_id", wordID );
+
+    if( !fromQuery.exec() )
+    {
+        ::logError( "SqLite error:" + fromQuery.lastError().text() );
+        throw "SqLite error:" + fromQuery.lastError().text();
+    }
+
+    QSqlQuery &toQuery = this->preparedQuery( "UPDATE OR IGNORE translations SET to_word_id = :into_word_id "
+                                              "WHERE to_word_id = :word_id" );
+
+    toQuery.bindValue( ":into_word_id", intoWordID );
+    toQuery.bindValue( ":word_id", wordID );
+
+    if( !toQuery.exec() )
+    {
+        ::logError( "SqLite error:" + toQuery.lastError().text() );
+        throw "SqLite error:" + toQuery.lastError().text();
+    }
+
+    // the ignored rows, already known to intoWordID, and the word itself
+    this->remove( wordID );
+}
+
+void DB_Manager::setStatementCacheEnabled( const bool enabled )
+{
+    this->statementCacheEnabled = enabled;
+    this->preparedQueries.clear();
+}
+
+QSqlQuery &DB_Manager::preparedQuery( const QString &sql ) const
+{
+    if( !this->statementCacheEnabled )
+    {
+        this->uncachedQuery = QSqlQuery( this->db );
+
+        if( !this->uncachedQuery.prepare( sql ) )
+        {
+            ::logError( "SqLite error:" + this->uncachedQuery.lastError().text() );
+            throw "SqLite error:" + this->uncachedQuery.lastError().text();
+        }
+
+        return this->uncachedQuery;
+    }
+
+    auto cached = this->preparedQueries.find( sql );
+
+    if( cached != this->preparedQueries.end() )
+    {
+        return cached.value();
+    }
+
+    QSqlQuery query( this->db );
+
+    if( !query.prepare( sql ) )
+    {
+        ::logError( "SqLite error:" + query.lastError().text() );
+        throw "SqLite error:" + query.lastError().text();
+    }
+
+    return this->preparedQueries.insert( sql, query ).value();
+}
+
+bool DB_Manager::tableExists( const QString &tableName ) const
+{
+    QSqlQuery query( this->db );
+
+    if( query.exec( "SELECT * FROM " + tableName ) )
+    {
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+void DB_Manager::migrate() const
+{
+    const int currentVersion = this->schemaVersion();
+
+    for( int version = currentVersion; version < schemaMigrations.size(); ++version )
+    {
+        // every step runs in its own transaction, so a failing step leaves
+        // the database at the last successfully applied version
+        QSqlDatabase connection{ this->db };
+        connection.transaction();
+
+        QSqlQuery query( this->db );
+
+        for( const QString &sql : schemaMigrations.at( version ) )
+        {
+            if( !query.exec( sql ) )
+            {
+                const QString error{ query.lastError().text() };
+                connection.rollback();
+
+                ::logError( "SqLite error:" + error );
+                throw "SqLite error:" + error;
+            }
+        }
+
+        // PRAGMA does not support bound values
+        if( !query.exec( "PRAGMA user_version = " + QString::number( version + 1 ) ) )
+        {
+            const QString error{ query.lastError().text() };
+            connection.rollback();
+
+            ::logError( "SqLite error:" + error );
+            throw "SqLite error:" + error;
+        }
+
+        connection.commit();
+
+        ::logInfo( QString{ "Database migrated to schema version %1" }.arg( version + 1 ) );
+    }
+}
@@ -0,0 +1,139 @@
+#ifndef DB_MANAGER_H
+#define DB_MANAGER_H
+
+#include <QHash>
+#include <QObject>
+#include <QPair>
+#include <QString>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QVector>
+
+enum class DB_Event
+{
+    DB_CONNECTION_FAILURE
+};
+
+struct ImportStatistics
+{
+    // lines of a word list, foreign words of a dictionary file
+    qint64 lines;
+    // imported pairs, including already known ones
+    qint64 pairs;
+    // lines without two words
+    qint64 skippedLines;
+    qint64 milliseconds;
+};
+
+class DB_Manager : public QObject
+{
+    Q_OBJECT
+
+public:
+    // every thread needs its own connection, see QSqlDatabase's thread-support notes
+    explicit DB_Manager( QObject *parent, const QString &dbName,
+                         const QString &connectionName = QLatin1String( QSqlDatabase::defaultConnection ) );
+    virtual ~DB_Manager();
+
+    bool isOk() const;
+    int schemaVersion() const;
+
+    // queries
+    QVector<QString> getLanguages() const;
+    int getLangId( const QString &langTag ) const;
+    QString getLangTag( const int &lang_id ) const;
+    int getWordId( const QString &word, const int &lang_id ) const;
+    QString getWord( const int word_id ) const;
+
+    bool isTranslatedWord( const QString &word, const int &lang_id ) const;
+    bool isKnownWord( const QString &word, const int &lang_id ) const;
+    QString getCurrentNativeLang() const;
+    QString getCurrentForeignLang() const;
+    void updateCurrentNativeLang( const QString &nativeLang ) const;
+    void updateCurrentForeignLang( const QString &foreignLang ) const;
+    // value of an optional key of the settings table, defaultValue if it isn't set
+    qint64 getSetting( const QString &key, const qint64 defaultValue ) const;
+
+    // counts the changes of words and translations, every writing call increments it.
+    // Anything derived from the translations is valid as long as the generation is the same
+    qint64 getDictionaryGeneration() const;
+    void translate( const QString &nativeWord, const int &nativeLangId,
+                    const QString &foreignWord, const int &foreignLangId ) const;
+
+    QVector<QString> getTanslations( const QString &from_word, const int &foreign_lang_id,
+                                     const int &native_lang_id ) const;
+
+    // resolves all given words at once; words without translation are not part of the result
+    QHash<QString, QVector<QString>> getTranslationsBatch( const QVector<QString> &from_words,
+                                                           const int &foreign_lang_id,
+                                                           const int &native_lang_id ) const;
+
+    // all ( foreign word, native word ) pairs of a language pair, grouped by foreign word
+    QVector<QPair<QString, QString>> getAllTranslations( const int &foreign_lang_id,
+                                                         const int &native_lang_id ) const;
+
+    // imports a TSV/CSV word list of "foreign<TAB>native" or "foreign,native" lines,
+    // translating every pair in both directions like translate(). Empty lines and lines
+    // starting with '#' are ignored. The file is streamed into one transaction,
+    // on errors nothing is imported
+    ImportStatistics importTranslations( const QString &fileName, const int &foreignLangId,
+                                         const int &nativeLangId ) const;
+
+    // streams all translations foreign -> native into a dictionary file, see DictionaryFile.
+    // Returns the count of foreign words written
+    int exportDictionary( const QString &fileName, const int &foreign_lang_id, const int &native_lang_id ) const;
+
+    // imports the translations of a dictionary file into the language pair stored in it,
+    // in both directions and in one transaction, like importTranslations()
+    ImportStatistics importDictionary( const QString &fileName ) const;
+
+    // dictionary file of a language pair kept next to the database for reading, see DictionaryIndex::map().
+    // Every dictionary generation has a file of its own, an export never replaces a mapped file
+    QString getDictionaryFileName( const int &foreign_lang_id, const int &native_lang_id ) const;
+    // removes the dictionary files of a language pair but keepFileName. Files still mapped
+    // can't be removed on Windows, they are left to a later call
+    void removeOutdatedDictionaryFiles( const int &foreign_lang_id, const int &native_lang_id,
+                                        const QString &keepFileName ) const;
+
+    // false if words or translations were changed after fileName was exported, or if it can't be read
+    bool isDictionaryFileCurrent( const QString &fileName ) const;
+
+    // translations of a language pair resolved in earlier sessions, see TranslationCache::save()
+    QString getTranslationCacheFileName( const int &foreign_lang_id, const int &native_lang_id ) const;
+
+    // renames a word, returns its id. Renamed to a word already known in its language,
+    // its translations are moved to the known word and the known word's id is returned
+    int update( const int wordID, const QString &word ) const;
+    void remove( const int wordID ) const;
+
+    // prepared statements are cached by default. Disabled, every query is prepared
+    // again, the baseline of the benchmarks
+    void setStatementCacheEnabled( const bool enabled );
+
+private:
+    bool tableExists( const QString &tableName ) const;
+    void migrate() const;
+    void insertNewWord( const QString &word, const int &lang_id ) const;
+    int upsertWord( const QString &word, const int &lang_id, QHash<QString, int> &wordIds ) const;
+    void upsertTranslation( const int from_word_id, const int to_word_id ) const;
+    void mergeWord( const int wordID, const int intoWordID ) const;
+    void nextDictionaryGeneration() const;
+    QString languagePairFileName( const int &foreign_lang_id, const int &native_lang_id,
+                                  const QString &suffix ) const;
+
+    // returns the cached prepared statement for sql, prepares it on first use.
+    // Don't hold the reference across another preparedQuery() call.
+    QSqlQuery &preparedQuery( const QString &sql ) const;
+
+    QSqlDatabase db;
+    QString dbName;
+    QString connectionName;
+
+    // one prepared statement per distinct SQL string, kept for the connection's lifetime
+    mutable QHash<QString, QSqlQuery> preparedQueries;
+    bool statementCacheEnabled;
+    // the statement of the last call while the cache is disabled
+    mutable QSqlQuery uncachedQuery;
+};
+
+#endif // DB_MANAGER_H
@@ -0,0 +1,623 @@
+#include "dictionaryfile.h"
+
+#include <QByteArray>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+    const quint32 byteOrderMark{ 0x01020304 };
+
+    // BloomFilter never uses more, a damaged count would make every lookup crawl
+    const quint32 maxFilterHashCount{ 16 };
+
+    // surrogates are moved behind U+E000..U+FFFF, then UTF-16 code units sort like code points
+    inline ushort codePointOrder( const ushort unit )
+    {
+        if( unit >= 0xE000 )
+        {
+            return static_cast<ushort>( unit - 0x800 );
+        }
+
+        if( unit >= 0xD800 )
+        {
+            return static_cast<ushort>( unit + 0x2000 );
+        }
+
+        return unit;
+    }
+
+    const quint32 *crcTable()
+    {
+        static const QVector<quint32> table = []()
+        {
+            QVector<quint32> crcs( 256 );
+
+            for( quint32 i = 0; i < 256; ++i )
+            {
+                quint32 crc = i;
+
+                for( int bit = 0; bit < 8; ++bit )
+                {
+                    crc = ( crc & 1 ) ? ( 0xEDB88320 ^ ( crc >> 1 ) ) : ( crc >> 1 );
+                }
+
+                crcs[static_cast<int>( i )] = crc;
+            }
+
+            return crcs;
+        }();
+
+        return table.constData();
+    }
+
+    QString langTag( const char *tag )
+    {
+        return QString::fromUtf8( tag, static_cast<int>( qstrnlen( tag, 16 ) ) );
+    }
+
+    void setLangTag( char *tag, const QString &lang )
+    {
+        const QByteArray utf8{ lang.toUtf8().left( 15 ) };
+        std::memset( tag, 0, 16 );
+        std::memcpy( tag, utf8.constData(), static_cast<size_t>( utf8.size() ) );
+    }
+
+    // true if count elements of elementSize at offset are inside of fileSize and aligned
+    bool isInside( const quint64 offset, const quint64 count, const quint64 elementSize, const quint64 fileSize )
+    {
+        return offset % elementSize == 0 &&
+               offset <= fileSize &&
+               count <= ( fileSize - offset ) / elementSize;
+    }
+
+    // true if every one of count ids is below limit
+    bool isBelow( const quint32 *ids, const quint64 count, const quint64 limit )
+    {
+        return std::all_of( ids, ids + count, [limit]( const quint32 id ) { return id < limit; } );
+    }
+
+    // true if the count + 1 offsets never decrease
+    bool isAscending( const quint32 *offsets, const quint64 count )
+    {
+        for( quint64 i = 0; i < count; ++i )
+        {
+            if( offsets[i] > offsets[i + 1] )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+quint32 DictionaryFile::crc32( const uchar *data, const qint64 size, const quint32 crc )
+{
+    const quint32 *table = crcTable();
+    quint32 c = ~crc;
+
+    for( qint64 i = 0; i < size; ++i )
+    {
+        c = table[( c ^ data[i] ) & 0xFF] ^ ( c >> 8 );
+    }
+
+    return ~c;
+}
+
+int DictionaryFile::compare( const QChar *a, const int aSize, const QChar *b, const int bSize )
+{
+    const int size = std::min( aSize, bSize );
+
+    for( int i = 0; i < size; ++i )
+    {
+        if( a[i] != b[i] )
+        {
+            return ( codePointOrder( a[i].unicode() ) < codePointOrder( b[i].unicode() ) ) ? -1 : 1;
+        }
+    }
+
+    return ( aSize == bSize ) ? 0 : ( ( aSize < bSize ) ? -1 : 1 );
+}
+
+QPair<QString, QString> DictionaryFile::readLanguages( const QString &fileName )
+{
+    QFile file{ fileName };
+    Header fileHeader;
+
+    if( !file.open( QFile::ReadOnly ) ||
+        file.read( reinterpret_cast<char*>( &fileHeader ), sizeof( Header ) ) != static_cast<qint64>( sizeof( Header ) ) ||
+        fileHeader.magic != DictionaryFile::magic || fileHeader.version != DictionaryFile::version ||
+        fileHeader.byteOrderMark != byteOrderMark )
+    {
+        return QPair<QString, QString>{};
+    }
+
+    return qMakePair( langTag( fileHeader.foreignLang ), langTag( fileHeader.nativeLang ) );
+}
+
+DictionaryFile::DictionaryFile()
+: data{ nullptr }
+, header{ nullptr }
+, stringPool{ nullptr }
+, stringOffsets{ nullptr }
+, entryWords{ nullptr }
+, sortedEntries{ nullptr }
+, csrOffsets{ nullptr }
+, csrTargets{ nullptr }
+, filterLookups{ 0 }
+, filterRejected{ 0 }
+, filterFalsePositives{ 0 }
+{
+}
+
+DictionaryFile::~DictionaryFile()
+{
+    this->close();
+}
+
+bool DictionaryFile::open( const QString &fileName, const bool verifyChecksum )
+{
+    this->close();
+    this->error.clear();
+    this->file.setFileName( fileName );
+
+    if( !this->file.open( QFile::ReadOnly ) )
+    {
+        return this->fail( this->file.errorString() );
+    }
+
+    const qint64 fileSize = this->file.size();
+
+    if( fileSize < static_cast<qint64>( sizeof( Header ) ) )
+    {
+        return this->fail( "Not a dictionary file" );
+    }
+
+    this->data = this->file.map( 0, fileSize );
+
+    if( this->data == nullptr )
+    {
+        return this->fail( this->file.errorString() );
+    }
+
+    // the mapping starts at a page boundary, every section is aligned to its element size
+    const Header *fileHeader = reinterpret_cast<const Header*>( this->data );
+
+    if( fileHeader->magic != DictionaryFile::magic )
+    {
+        return this->fail( "Not a dictionary file" );
+    }
+
+    if( fileHeader->version != DictionaryFile::version )
+    {
+        return this->fail( QString{ "Unsupported dictionary file version %1" }.arg( fileHeader->version ) );
+    }
+
+    if( fileHeader->byteOrderMark != byteOrderMark )
+    {
+        return this->fail( "Dictionary file was written with another byte order" );
+    }
+
+    const quint64 size = static_cast<quint64>( fileSize );
+
+    const quint64 maxCount{ static_cast<quint64>( std::numeric_limits<int>::max() ) };
+
+    if( fileHeader->headerSize != sizeof( Header ) || fileHeader->fileSize != size ||
+        fileHeader->stringCount >= maxCount || fileHeader->entryCount >= maxCount ||
+        fileHeader->translationCount >= maxCount || fileHeader->filterWordCount >= maxCount ||
+        fileHeader->filterHashCount > maxFilterHashCount ||
+        !isInside( fileHeader->stringOffsetsOffset, fileHeader->stringCount + 1ULL, 4, size ) ||
+        !isInside( fileHeader->entryWordsOffset, fileHeader->entryCount, 4, size ) ||
+        !isInside( fileHeader->sortedEntriesOffset, fileHeader->entryCount, 4, size ) ||
+        !isInside( fileHeader->csrOffsetsOffset, fileHeader->entryCount + 1ULL, 4, size ) ||
+        !isInside( fileHeader->csrTargetsOffset, fileHeader->translationCount, 4, size ) ||
+        !isInside( fileHeader->filterOffset, fileHeader->filterWordCount, 8, size ) )
+    {
+        return this->fail( "Dictionary file is truncated or damaged" );
+    }
+
+    if( verifyChecksum &&
+        DictionaryFile::crc32( this->data + sizeof( Header ), fileSize - static_cast<qint64>( sizeof( Header ) ) )
+            != fileHeader->checksum )
+    {
+        return this->fail( "Checksum of the dictionary file doesn't match" );
+    }
+
+    // pointer fixups, nothing else has to be read
+    this->header = fileHeader;
+    this->stringOffsets = reinterpret_cast<const quint32*>( this->data + fileHeader->stringOffsetsOffset );
+    this->entryWords = reinterpret_cast<const quint32*>( this->data + fileHeader->entryWordsOffset );
+    this->sortedEntries = reinterpret_cast<const quint32*>( this->data + fileHeader->sortedEntriesOffset );
+    this->csrOffsets = reinterpret_cast<const quint32*>( this->data + fileHeader->csrOffsetsOffset );
+    this->csrTargets = reinterpret_cast<const quint32*>( this->data + fileHeader->csrTargetsOffset );
+
+    // lookups use the ids and offsets without any check, they are checked once here.
+    // One pass over the arrays, a lot less than the checksum reads
+    if( !isInside( fileHeader->stringPoolOffset, this->stringOffsets[fileHeader->stringCount], 2, size ) ||
+        !isAscending( this->stringOffsets, fileHeader->stringCount ) ||
+        !isBelow( this->entryWords, fileHeader->entryCount, fileHeader->stringCount ) ||
+        !isBelow( this->sortedEntries, fileHeader->entryCount, fileHeader->entryCount ) ||
+        !isAscending( this->csrOffsets, fileHeader->entryCount ) ||
+        this->csrOffsets[fileHeader->entryCount] > fileHeader->translationCount ||
+        !isBelow( this->csrTargets, fileHeader->translationCount, fileHeader->stringCount ) )
+    {
+        this->header = nullptr;
+        return this->fail( "Dictionary file is truncated or damaged" );
+    }
+
+    this->stringPool = reinterpret_cast<const QChar*>( this->data + fileHeader->stringPoolOffset );
+    this->filter = BloomFilter::fromRawData( reinterpret_cast<const quint64*>( this->data + fileHeader->filterOffset ),
+                                             static_cast<int>( fileHeader->filterWordCount ),
+                                             static_cast<int>( fileHeader->filterHashCount ) );
+
+    return true;
+}
+
+void DictionaryFile::close()
+{
+    if( this->data != nullptr )
+    {
+        this->file.unmap( const_cast<uchar*>( this->data ) );
+    }
+
+    this->file.close();
+
+    this->data = nullptr;
+    this->header = nullptr;
+    this->stringPool = nullptr;
+    this->stringOffsets = nullptr;
+    this->entryWords = nullptr;
+    this->sortedEntries = nullptr;
+    this->csrOffsets = nullptr;
+    this->csrTargets = nullptr;
+    this->filter = BloomFilter{};
+
+    this->filterLookups = 0;
+    this->filterRejected = 0;
+    this->filterFalsePositives = 0;
+}
+
+bool DictionaryFile::isOpen() const
+{
+    return this->header != nullptr;
+}
+
+QString DictionaryFile::fileName() const
+{
+    return this->file.fileName();
+}
+
+QString DictionaryFile::errorString() const
+{
+    return this->error;
+}
+
+QString DictionaryFile::getForeignLang() const
+{
+    return this->isOpen() ? langTag( this->header->foreignLang ) : QString{};
+}
+
+QString DictionaryFile::getNativeLang() const
+{
+    return this->isOpen() ? langTag( this->header->nativeLang ) : QString{};
+}
+
+qint64 DictionaryFile::getGeneration() const
+{
+    return this->isOpen() ? this->header->generation : -1;
+}
+
+int DictionaryFile::size() const
+{
+    return this->isOpen() ? static_cast<int>( this->header->entryCount ) : 0;
+}
+
+int DictionaryFile::translationCount() const
+{
+    return this->isOpen() ? static_cast<int>( this->header->translationCount ) : 0;
+}
+
+int DictionaryFile::findEntry( const QString &foreignWord ) const
+{
+    if( !this->filter.isNull() )
+    {
+        this->filterLookups.fetch_add( 1, std::memory_order_relaxed );
+
+        if( !this->filter.mightContain( foreignWord ) )
+        {
+            this->filterRejected.fetch_add( 1, std::memory_order_relaxed );
+            return -1;
+        }
+    }
+
+    int low = 0;
+    int high = this->size() - 1;
+
+    while( low <= high )
+    {
+        const int middle = low + ( high - low ) / 2;
+        const quint32 entryId = this->sortedEntries[middle];
+        const quint32 stringId = this->entryWords[entryId];
+        const quint32 offset = this->stringOffsets[stringId];
+
+        const int order = DictionaryFile::compare( this->stringPool + offset,
+                                                   static_cast<int>( this->stringOffsets[stringId + 1] - offset ),
+                                                   foreignWord.constData(), foreignWord.size() );
+
+        if( order == 0 )
+        {
+            return static_cast<int>( entryId );
+        }
+
+        if( order < 0 )
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+
+    if( !this->filter.isNull() )
+    {
+        this->filterFalsePositives.fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    return -1;
+}
+
+bool DictionaryFile::contains( const QString &foreignWord ) const
+{
+    return this->findEntry( foreignWord ) >= 0;
+}
+
+QVector<QString> DictionaryFile::getTranslations( const QString &foreignWord ) const
+{
+    QVector<QString> translations;
+
+    const int entryId = this->findEntry( foreignWord );
+
+    if( entryId < 0 )
+    {
+        return translations;
+    }
+
+    // deep copies, they may outlive the mapping
+    for( const QString &translation : this->entryTranslations( entryId ) )
+    {
+        translations.push_back( QString{ translation.constData(), translation.size() } );
+    }
+
+    return translations;
+}
+
+BloomFilterStatistics DictionaryFile::getFilterStatistics() const
+{
+    return BloomFilterStatistics{ this->filterLookups.load(),
+                                  this->filterRejected.load(),
+                                  this->filterFalsePositives.load(),
+                                  this->filter.expectedFalsePositiveRate( static_cast<quint64>( this->size() ) ) };
+}
+
+QString DictionaryFile::entryWord( const int entryId ) const
+{
+    return this->string( this->entryWords[entryId] );
+}
+
+QVector<QString> DictionaryFile::entryTranslations( const int entryId ) const
+{
+    const quint32 begin = this->csrOffsets[entryId];
+    const quint32 end = this->csrOffsets[entryId + 1];
+
+    QVector<QString> translations;
+    translations.reserve( static_cast<int>( end - begin ) );
+
+    for( quint32 i = begin; i < end; ++i )
+    {
+        translations.push_back( this->string( this->csrTargets[i] ) );
+    }
+
+    return translations;
+}
+
+QVector<QPair<QString, QString>> DictionaryFile::getAllTranslations() const
+{
+    QVector<QPair<QString, QString>> translations;
+    translations.reserve( this->translationCount() );
+
+    for( int entryId = 0; entryId < this->size(); ++entryId )
+    {
+        const QString word{ this->entryWord( entryId ) };
+        const QString foreignWord{ word.constData(), word.size() };
+
+        for( const QString &translation : this->entryTranslations( entryId ) )
+        {
+            translations.push_back( qMakePair( foreignWord, QString{ translation.constData(), translation.size() } ) );
+        }
+    }
+
+    return translations;
+}
+
+bool DictionaryFile::fail( const QString &error )
+{
+    this->close();
+    this->error = error;
+
+    return false;
+}
+
+// points into the mapping, nothing is copied
+QString DictionaryFile::string( const quint32 stringId ) const
+{
+    const quint32 offset = this->stringOffsets[stringId];
+
+    return QString::fromRawData( this->stringPool + offset, static_cast<int>( this->stringOffsets[stringId + 1] - offset ) );
+}
+
+DictionaryFileWriter::DictionaryFileWriter( const QString &fileName )
+: file{ fileName }
+, header{}
+, checksum{ 0 }
+, writtenBytes{ 0 }
+, failed{ false }
+, stringOffsets{ 0 }
+, csrOffsets{ 0 }
+, currentForeignWordId{ -1 }
+{
+}
+
+bool DictionaryFileWriter::open( const QString &foreignLang, const QString &nativeLang, const qint64 generation )
+{
+    if( !this->file.open( QFile::WriteOnly ) )
+    {
+        this->failed = true;
+        return false;
+    }
+
+    std::memset( &this->header, 0, sizeof( this->header ) );
+    this->header.magic = DictionaryFile::magic;
+    this->header.version = DictionaryFile::version;
+    this->header.byteOrderMark = byteOrderMark;
+    this->header.headerSize = sizeof( DictionaryFile::Header );
+    setLangTag( this->header.foreignLang, foreignLang );
+    setLangTag( this->header.nativeLang, nativeLang );
+    this->header.generation = generation;
+
+    // placeholder, the header is written again by commit()
+    if( this->file.write( reinterpret_cast<const char*>( &this->header ), sizeof( this->header ) )
+            != static_cast<qint64>( sizeof( this->header ) ) )
+    {
+        this->failed = true;
+        return false;
+    }
+
+    this->writtenBytes = sizeof( this->header );
+    this->header.stringPoolOffset = this->writtenBytes;
+
+    return true;
+}
+
+void DictionaryFileWriter::addTranslation( const int foreignWordId, const QString &foreignWord,
+                                           const int nativeWordId, const QString &nativeWord )
+{
+    if( foreignWordId != this->currentForeignWordId )
+    {
+        this->currentForeignWordId = foreignWordId;
+
+        this->entryWords.push_back( this->addString( foreignWord ) );
+        this->entryWordStrings.push_back( foreignWord );
+        this->csrOffsets.push_back( this->csrOffsets.last() );
+    }
+
+    auto nativeStringId = this->nativeStringIds.find( nativeWordId );
+
+    if( nativeStringId == this->nativeStringIds.end() )
+    {
+        nativeStringId = this->nativeStringIds.insert( nativeWordId, this->addString( nativeWord ) );
+    }
+
+    this->csrTargets.push_back( nativeStringId.value() );
+    this->csrOffsets.last() = static_cast<quint32>( this->csrTargets.size() );
+}
+
+bool DictionaryFileWriter::commit()
+{
+    QVector<quint32> sortedEntries( this->entryWords.size() );
+    std::iota( sortedEntries.begin(), sortedEntries.end(), 0 );
+
+    std::stable_sort( sortedEntries.begin(), sortedEntries.end(),
+                      [this]( const quint32 a, const quint32 b )
+                      {
+                          const QString &aWord = this->entryWordStrings.at( static_cast<int>( a ) );
+                          const QString &bWord = this->entryWordStrings.at( static_cast<int>( b ) );
+
+                          return DictionaryFile::compare( aWord.constData(), aWord.size(),
+                                                          bWord.constData(), bWord.size() ) < 0;
+                      } );
+
+    // the string pool may end at an odd code unit
+    const quint64 padding{ ( 8 - this->writtenBytes % 8 ) % 8 };
+    const char zeros[8]{};
+    this->write( zeros, static_cast<qint64>( padding ) );
+
+    auto writeArray = [this]( const QVector<quint32> &array, quint64 &offset )
+    {
+        offset = this->writtenBytes;
+        this->write( array.constData(), static_cast<qint64>( array.size() ) * 4 );
+    };
+
+    writeArray( this->stringOffsets, this->header.stringOffsetsOffset );
+    writeArray( this->entryWords, this->header.entryWordsOffset );
+    writeArray( sortedEntries, this->header.sortedEntriesOffset );
+    writeArray( this->csrOffsets, this->header.csrOffsetsOffset );
+    writeArray( this->csrTargets, this->header.csrTargetsOffset );
+
+    BloomFilter filter{ this->entryWordStrings.size() };
+
+    for( const QString &word : this->entryWordStrings )
+    {
+        filter.insert( word );
+    }
+
+    // the filter is an array of quint64, csrTargets may end in the middle of one
+    this->write( zeros, static_cast<qint64>( ( 8 - this->writtenBytes % 8 ) % 8 ) );
+
+    this->header.filterOffset = this->writtenBytes;
+    this->header.filterWordCount = static_cast<quint32>( filter.wordCount() );
+    this->header.filterHashCount = static_cast<quint32>( filter.hashCount() );
+    this->write( filter.constData(), static_cast<qint64>( filter.wordCount() ) * 8 );
+
+    this->header.fileSize = this->writtenBytes;
+    this->header.checksum = this->checksum;
+    this->header.entryCount = static_cast<quint32>( this->entryWords.size() );
+    this->header.stringCount = static_cast<quint32>( this->stringOffsets.size() - 1 );
+    this->header.translationCount = static_cast<quint32>( this->csrTargets.size() );
+
+    if( this->failed || !this->file.seek( 0 ) ||
+        this->file.write( reinterpret_cast<const char*>( &this->header ), sizeof( this->header ) )
+            != static_cast<qint64>( sizeof( this->header ) ) )
+    {
+        this->file.cancelWriting();
+        return false;
+    }
+
+    return this->file.commit();
+}
+
+QString DictionaryFileWriter::errorString() const
+{
+    return this->file.errorString();
+}
+
+quint32 DictionaryFileWriter::addString( const QString &str )
+{
+    this->write( str.constData(), static_cast<qint64>( str.size() ) * 2 );
+    this->stringOffsets.push_back( this->stringOffsets.last() + static_cast<quint32>( str.size() ) );
+
+    return static_cast<quint32>( this->stringOffsets.size() - 2 );
+}
+
+bool DictionaryFileWriter::write( const void *bytes, const qint64 size )
+{
+    if( this->failed )
+    {
+        return false;
+    }
+
+    if( this->file.write( static_cast<const char*>( bytes ), size ) != size )
+    {
+        this->failed = true;
+        return false;
+    }
+
+    this->checksum = DictionaryFile::crc32( static_cast<const uchar*>( bytes ), size, this->checksum );
+    this->writtenBytes += static_cast<quint64>( size );
+
+    return true;
+}
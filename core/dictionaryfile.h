@@ -0,0 +1,184 @@
+#ifndef DICTIONARYFILE_H
+#define DICTIONARYFILE_H
+
+#include <QFile>
+#include <QHash>
+#include <QPair>
+#include <QSaveFile>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+
+#include "bloomfilter.h"
+
+// Compact binary snapshot of all translations of one foreign -> native language pair.
+//
+// The file is little endian and memory-mappable, everything is addressed by offsets
+// from the header, so opening it means checking the header and fixing up pointers:
+//
+//   header          DictionaryFile::Header
+//   string pool     UTF-16 code units of all words, back to back
+//   stringOffsets   quint32[stringCount + 1], string i is pool[offsets[i] .. offsets[i+1]]
+//   entryWords      quint32[entryCount], string id of the foreign word of every entry
+//   sortedEntries   quint32[entryCount], entry ids sorted by their foreign word (code point order)
+//   csrOffsets      quint32[entryCount + 1], translations of entry i are csrTargets[csrOffsets[i] .. csrOffsets[i+1]]
+//   csrTargets      quint32[translationCount], string ids of the native words
+//   filter          quint64[filterWordCount], BloomFilter of the foreign words
+//
+// The header records the dictionary generation of the database the file was exported
+// from, see DB_Manager::isDictionaryFileCurrent().
+//
+// The CRC-32 in the header covers everything after the header. Lookups ask the
+// filter first, most words of a text aren't in the dictionary of a beginner and
+// skip the binary search that way.
+class DictionaryFile
+{
+public:
+    static const quint32 magic{ 0x4454434D };   // "MCTD"
+    static const quint32 version{ 3 };
+
+    struct Header
+    {
+        quint32 magic;
+        quint32 version;
+        // written as 0x01020304 by the native byte order of the writer
+        quint32 byteOrderMark;
+        quint32 headerSize;
+        quint64 fileSize;
+        quint32 checksum;
+        quint32 entryCount;
+        quint32 stringCount;
+        quint32 translationCount;
+        quint64 stringPoolOffset;
+        quint64 stringOffsetsOffset;
+        quint64 entryWordsOffset;
+        quint64 sortedEntriesOffset;
+        quint64 csrOffsetsOffset;
+        quint64 csrTargetsOffset;
+        quint64 filterOffset;
+        quint32 filterWordCount;
+        quint32 filterHashCount;
+        // language tags, zero padded
+        char foreignLang[16];
+        char nativeLang[16];
+        // DB_Manager::getDictionaryGeneration() when the export started
+        qint64 generation;
+    };
+
+    // CRC-32 (IEEE 802.3) of size bytes at data, continuing crc
+    static quint32 crc32( const uchar *data, const qint64 size, const quint32 crc = 0 );
+
+    // compares two strings by code point, like SQLite's BINARY collation does for UTF-8
+    static int compare( const QChar *a, const int aSize, const QChar *b, const int bSize );
+
+    // ( foreign, native ) language tags of fileName, read from the header alone without mapping
+    // or checking the rest of the file. Empty if it isn't a dictionary file of this version
+    static QPair<QString, QString> readLanguages( const QString &fileName );
+
+    DictionaryFile();
+    ~DictionaryFile();
+
+    DictionaryFile( const DictionaryFile & ) = delete;
+    DictionaryFile &operator=( const DictionaryFile & ) = delete;
+
+    // maps fileName read-only, returns false if it isn't a valid dictionary file, see errorString().
+    // Every id and offset is checked, without verifyChecksum a damaged file may still return
+    // wrong words, but never makes a lookup read outside of the mapping
+    bool open( const QString &fileName, const bool verifyChecksum = true );
+    void close();
+
+    bool isOpen() const;
+    QString fileName() const;
+    QString errorString() const;
+
+    QString getForeignLang() const;
+    QString getNativeLang() const;
+    // dictionary generation the file was exported from, -1 if it isn't open
+    qint64 getGeneration() const;
+
+    int size() const;
+    int translationCount() const;
+
+    // entry of foreignWord found by binary search, -1 if there is none
+    int findEntry( const QString &foreignWord ) const;
+    bool contains( const QString &foreignWord ) const;
+    QVector<QString> getTranslations( const QString &foreignWord ) const;
+
+    // lookups answered by the filter so far, counted by all threads reading the file
+    BloomFilterStatistics getFilterStatistics() const;
+
+    // the returned strings point into the mapping, they are valid until close()
+    QString entryWord( const int entryId ) const;
+    QVector<QString> entryTranslations( const int entryId ) const;
+
+    // all ( foreign word, native word ) pairs, grouped by foreign word, see DictionaryIndex::build()
+    QVector<QPair<QString, QString>> getAllTranslations() const;
+
+private:
+    bool fail( const QString &error );
+    QString string( const quint32 stringId ) const;
+
+    QFile file;
+    QString error;
+    const uchar *data;
+    const Header *header;
+    const QChar *stringPool;
+    const quint32 *stringOffsets;
+    const quint32 *entryWords;
+    const quint32 *sortedEntries;
+    const quint32 *csrOffsets;
+    const quint32 *csrTargets;
+    BloomFilter filter;
+
+    mutable std::atomic<quint64> filterLookups;
+    mutable std::atomic<quint64> filterRejected;
+    mutable std::atomic<quint64> filterFalsePositives;
+};
+
+// Streams a dictionary file to disk. Strings are written as soon as they are added,
+// only the id arrays and the foreign words (to sort them) are kept in memory.
+// fileName appears complete in commit() or not at all. It must not be mapped, replacing
+// a mapped file fails on Windows: DB_Manager writes every generation to a new file.
+class DictionaryFileWriter
+{
+public:
+    explicit DictionaryFileWriter( const QString &fileName );
+
+    DictionaryFileWriter( const DictionaryFileWriter & ) = delete;
+    DictionaryFileWriter &operator=( const DictionaryFileWriter & ) = delete;
+
+    bool open( const QString &foreignLang, const QString &nativeLang, const qint64 generation );
+
+    // translations have to be added grouped by foreign word. Word ids only identify
+    // words, so every native word is stored once
+    void addTranslation( const int foreignWordId, const QString &foreignWord,
+                         const int nativeWordId, const QString &nativeWord );
+
+    // writes the arrays and the header, returns false if anything couldn't be written
+    bool commit();
+
+    QString errorString() const;
+
+private:
+    quint32 addString( const QString &str );
+    bool write( const void *bytes, const qint64 size );
+
+    QSaveFile file;
+    DictionaryFile::Header header;
+    quint32 checksum;
+    quint64 writtenBytes;
+    bool failed;
+
+    QVector<quint32> stringOffsets;
+    QVector<quint32> entryWords;
+    QVector<QString> entryWordStrings;
+    QVector<quint32> csrOffsets;
+    QVector<quint32> csrTargets;
+    int currentForeignWordId;
+
+    // native word id -> string id
+    QHash<int, quint32> nativeStringIds;
+};
+
+#endif // DICTIONARYFILE_H
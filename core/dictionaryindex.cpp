@@ -0,0 +1,356 @@
+#include "dictionaryindex.h"
+
+#include "dictionaryfile.h"
+
+namespace
+{
+    // keeps the hash table at most half full
+    int slotCapacityFor( const int entryCount )
+    {
+        int capacity = 16;
+
+        while( capacity < entryCount * 2 )
+        {
+            capacity *= 2;
+        }
+
+        return capacity;
+    }
+}
+
+DictionaryIndex::DictionaryIndex()
+{
+    this->clear();
+}
+
+void DictionaryIndex::build( const QVector<QPair<QString, QString>> &translations )
+{
+    this->clear();
+
+    int poolSize = 0;
+
+    for( const QPair<QString, QString> &translation : translations )
+    {
+        poolSize += translation.first.size() + translation.second.size();
+    }
+
+    this->stringPool.reserve( poolSize );
+    this->csrTargets.reserve( translations.size() );
+
+    // native words are shared between all foreign words translated to them
+    QHash<QString, int> nativeStringIds;
+    int currentEntry = -1;
+
+    for( const QPair<QString, QString> &translation : translations )
+    {
+        if( currentEntry < 0 || this->string( this->entryWords.at( currentEntry ) ) != translation.first )
+        {
+            currentEntry = this->findEntry( translation.first, qHash( translation.first ) );
+
+            if( currentEntry < 0 )
+            {
+                currentEntry = this->addEntry( translation.first );
+                this->csrOffsets.push_back( this->csrTargets.size() );
+            }
+        }
+
+        // input is grouped by foreign word, an already closed CSR row can't grow anymore
+        if( currentEntry != this->entryWords.size() - 1 )
+        {
+            QVector<int> patched{ this->adjacency( currentEntry ) };
+            patched.push_back( this->addString( translation.second ) );
+            this->patchedAdjacency.insert( currentEntry, patched );
+            continue;
+        }
+
+        auto nativeStringId = nativeStringIds.find( translation.second );
+
+        if( nativeStringId == nativeStringIds.end() )
+        {
+            nativeStringId = nativeStringIds.insert( translation.second, this->addString( translation.second ) );
+        }
+
+        this->csrTargets.push_back( nativeStringId.value() );
+        this->csrOffsets.last() = this->csrTargets.size();
+    }
+
+    this->stringPool.squeeze();
+    this->csrTargets.squeeze();
+}
+
+void DictionaryIndex::clear()
+{
+    this->stringPool.clear();
+    this->stringOffsets = QVector<int>{ 0 };
+    this->entryWords.clear();
+    this->entryHashes.clear();
+    this->slots = QVector<int>( slotCapacityFor( 0 ), -1 );
+    this->csrOffsets = QVector<int>{ 0 };
+    this->csrTargets.clear();
+    this->patchedAdjacency.clear();
+    this->mappedFile.reset();
+    this->patchedTranslations.clear();
+}
+
+bool DictionaryIndex::map( const QString &fileName, const QString &foreignLang, const QString &nativeLang )
+{
+    QSharedPointer<DictionaryFile> dictionary{ new DictionaryFile };
+
+    // the checksum would read the whole file. The files are written through a QSaveFile,
+    // they are complete or not there at all, damaged ones are still rejected by open()
+    if( !dictionary->open( fileName, false ) ||
+        dictionary->getForeignLang() != foreignLang || dictionary->getNativeLang() != nativeLang )
+    {
+        return false;
+    }
+
+    this->clear();
+    this->mappedFile = dictionary;
+
+    return true;
+}
+
+bool DictionaryIndex::isMapped() const
+{
+    return !this->mappedFile.isNull();
+}
+
+BloomFilterStatistics DictionaryIndex::getFilterStatistics() const
+{
+    return this->isMapped() ? this->mappedFile->getFilterStatistics() : BloomFilterStatistics{ 0, 0, 0, 0.0 };
+}
+
+bool DictionaryIndex::isEmpty() const
+{
+    return this->size() == 0;
+}
+
+int DictionaryIndex::size() const
+{
+    if( this->isMapped() )
+    {
+        int added = 0;
+
+        for( auto patched = this->patchedTranslations.begin(); patched != this->patchedTranslations.end(); ++patched )
+        {
+            if( !this->mappedFile->contains( patched.key() ) )
+            {
+                ++added;
+            }
+        }
+
+        return this->mappedFile->size() + added;
+    }
+
+    return this->entryWords.size();
+}
+
+bool DictionaryIndex::contains( const QString &foreignWord ) const
+{
+    if( this->isMapped() )
+    {
+        auto patched = this->patchedTranslations.find( foreignWord );
+
+        return ( patched != this->patchedTranslations.end() ) ? !patched.value().isEmpty()
+                                                              : this->mappedFile->contains( foreignWord );
+    }
+
+    const int entryId = this->findEntry( foreignWord, qHash( foreignWord ) );
+
+    return entryId >= 0 && !this->adjacency( entryId ).isEmpty();
+}
+
+QVector<QString> DictionaryIndex::getTranslations( const QString &foreignWord ) const
+{
+    if( this->isMapped() )
+    {
+        auto patched = this->patchedTranslations.find( foreignWord );
+
+        return ( patched != this->patchedTranslations.end() ) ? patched.value()
+                                                              : this->mappedFile->getTranslations( foreignWord );
+    }
+
+    QVector<QString> translations;
+
+    const int entryId = this->findEntry( foreignWord, qHash( foreignWord ) );
+
+    if( entryId < 0 )
+    {
+        return translations;
+    }
+
+    const QVector<int> nativeStringIds{ this->adjacency( entryId ) };
+    translations.reserve( nativeStringIds.size() );
+
+    for( const int stringId : nativeStringIds )
+    {
+        translations.push_back( this->string( stringId ).toString() );
+    }
+
+    return translations;
+}
+
+void DictionaryIndex::addTranslation( const QString &foreignWord, const QString &translation )
+{
+    if( this->isMapped() )
+    {
+        QVector<QString> patched{ this->getTranslations( foreignWord ) };
+
+        if( !patched.contains( translation ) )
+        {
+            patched.push_back( translation );
+            this->patchedTranslations.insert( foreignWord, patched );
+        }
+
+        return;
+    }
+
+    int entryId = this->findEntry( foreignWord, qHash( foreignWord ) );
+
+    if( entryId < 0 )
+    {
+        entryId = this->addEntry( foreignWord );
+    }
+
+    QVector<int> patched{ this->adjacency( entryId ) };
+
+    for( const int stringId : patched )
+    {
+        if( this->string( stringId ) == translation )
+        {
+            return;
+        }
+    }
+
+    patched.push_back( this->addString( translation ) );
+    this->patchedAdjacency.insert( entryId, patched );
+}
+
+void DictionaryIndex::removeTranslation( const QString &foreignWord, const QString &translation )
+{
+    if( this->isMapped() )
+    {
+        QVector<QString> patched{ this->getTranslations( foreignWord ) };
+        patched.removeAll( translation );
+        this->patchedTranslations.insert( foreignWord, patched );
+
+        return;
+    }
+
+    const int entryId = this->findEntry( foreignWord, qHash( foreignWord ) );
+
+    if( entryId < 0 )
+    {
+        return;
+    }
+
+    QVector<int> patched{ this->adjacency( entryId ) };
+
+    for( int i = patched.size() - 1; i >= 0; --i )
+    {
+        if( this->string( patched.at( i ) ) == translation )
+        {
+            patched.remove( i );
+        }
+    }
+
+    this->patchedAdjacency.insert( entryId, patched );
+}
+
+int DictionaryIndex::addString( const QString &str )
+{
+    this->stringPool.append( str );
+    this->stringOffsets.push_back( this->stringPool.size() );
+
+    return this->stringOffsets.size() - 2;
+}
+
+QStringRef DictionaryIndex::string( const int stringId ) const
+{
+    const int offset = this->stringOffsets.at( stringId );
+
+    return QStringRef{ &this->stringPool, offset, this->stringOffsets.at( stringId + 1 ) - offset };
+}
+
+int DictionaryIndex::addEntry( const QString &foreignWord )
+{
+    this->entryWords.push_back( this->addString( foreignWord ) );
+    this->entryHashes.push_back( qHash( foreignWord ) );
+
+    const int entryId = this->entryWords.size() - 1;
+
+    if( this->entryWords.size() * 2 > this->slots.size() )
+    {
+        this->rehash( this->slots.size() * 2 );
+    }
+    else
+    {
+        this->insertSlot( entryId );
+    }
+
+    return entryId;
+}
+
+int DictionaryIndex::findEntry( const QString &foreignWord, const uint hash ) const
+{
+    const int mask = this->slots.size() - 1;
+
+    for( int slot = static_cast<int>( hash & static_cast<uint>( mask ) ); ; slot = ( slot + 1 ) & mask )
+    {
+        const int entryId = this->slots.at( slot );
+
+        if( entryId < 0 )
+        {
+            return -1;
+        }
+
+        if( this->entryHashes.at( entryId ) == hash &&
+            this->string( this->entryWords.at( entryId ) ) == foreignWord )
+        {
+            return entryId;
+        }
+    }
+}
+
+void DictionaryIndex::insertSlot( const int entryId )
+{
+    const int mask = this->slots.size() - 1;
+    int slot = static_cast<int>( this->entryHashes.at( entryId ) & static_cast<uint>( mask ) );
+
+    while( this->slots.at( slot ) >= 0 )
+    {
+        slot = ( slot + 1 ) & mask;
+    }
+
+    this->slots[slot] = entryId;
+}
+
+void DictionaryIndex::rehash( const int capacity )
+{
+    this->slots = QVector<int>( capacity, -1 );
+
+    for( int entryId = 0; entryId < this->entryWords.size(); ++entryId )
+    {
+        this->insertSlot( entryId );
+    }
+}
+
+QVector<int> DictionaryIndex::adjacency( const int entryId ) const
+{
+    auto patched = this->patchedAdjacency.find( entryId );
+
+    if( patched != this->patchedAdjacency.end() )
+    {
+        return patched.value();
+    }
+
+    // entries added after build() have no CSR row
+    if( entryId + 1 >= this->csrOffsets.size() )
+    {
+        return QVector<int>{};
+    }
+
+    const int begin = this->csrOffsets.at( entryId );
+
+    return this->csrTargets.mid( begin, this->csrOffsets.at( entryId + 1 ) - begin );
+}
@@ -0,0 +1,90 @@
+#ifndef DICTIONARYINDEX_H
+#define DICTIONARYINDEX_H
+
+#include <QHash>
+#include <QPair>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringRef>
+#include <QVector>
+
+#include "bloomfilter.h"
+
+// Forward-Declarations
+class DictionaryFile;
+
+// Read optimised in-memory snapshot of all translations of one
+// foreign -> native language pair.
+//
+// - all strings are stored back to back in one string pool
+// - foreign words are found via an open-addressing hash table (linear probing)
+// - translations are stored as CSR adjacency array (entry -> native string ids)
+//
+// Edits after build() are kept in a small overlay, so the CSR arrays never
+// have to be rebuilt for a single added or removed translation.
+//
+// Instead of being built, the index can map an exported dictionary file (see
+// DictionaryFile), lookups are binary searches in the mapping then. Edits are
+// kept in an overlay as well, the file itself is never written.
+class DictionaryIndex
+{
+public:
+    DictionaryIndex();
+
+    // pairs of ( foreign word, native word ), grouped by foreign word
+    void build( const QVector<QPair<QString, QString>> &translations );
+    void clear();
+
+    // maps fileName instead of building the index, only the ids and offsets are checked here.
+    // Copies of the index share the mapping. Returns false if the file can't be mapped
+    // or is of another language pair, the index is left unchanged then
+    bool map( const QString &fileName, const QString &foreignLang, const QString &nativeLang );
+    bool isMapped() const;
+
+    // lookups the Bloom filter of the mapped file answered, all zero if not mapped
+    BloomFilterStatistics getFilterStatistics() const;
+
+    bool isEmpty() const;
+    int size() const;
+
+    bool contains( const QString &foreignWord ) const;
+    QVector<QString> getTranslations( const QString &foreignWord ) const;
+
+    void addTranslation( const QString &foreignWord, const QString &translation );
+    void removeTranslation( const QString &foreignWord, const QString &translation );
+
+private:
+    int addString( const QString &str );
+    QStringRef string( const int stringId ) const;
+    int addEntry( const QString &foreignWord );
+    int findEntry( const QString &foreignWord, const uint hash ) const;
+    void insertSlot( const int entryId );
+    void rehash( const int capacity );
+    QVector<int> adjacency( const int entryId ) const;
+
+    // string pool, stringOffsets[id] .. stringOffsets[id+1] is string id
+    QString stringPool;
+    QVector<int> stringOffsets;
+
+    // entry id -> string id of the foreign word and its hash
+    QVector<int> entryWords;
+    QVector<uint> entryHashes;
+
+    // open-addressing hash table of entry ids, -1 marks an empty slot
+    QVector<int> slots;
+
+    // CSR: translations of entry i are csrTargets[csrOffsets[i] .. csrOffsets[i+1]]
+    QVector<int> csrOffsets;
+    QVector<int> csrTargets;
+
+    // entries changed after build(), replaces their CSR row
+    QHash<int, QVector<int>> patchedAdjacency;
+
+    // read-only and shared by all copies, replaces the arrays above if set
+    QSharedPointer<const DictionaryFile> mappedFile;
+
+    // words changed after map(), replaces their translations of the file
+    QHash<QString, QVector<QString>> patchedTranslations;
+};
+
+#endif // DICTIONARYINDEX_H
@@ -0,0 +1,216 @@
+/* ---- spdlog - COPYRIGHT NOTICE ----
+
+    The MIT License (MIT)
+
+    Copyright (c) 2016 Gabi Melman.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+
+*/
+
+#include "log.h"
+
+#include "spdlog/spdlog.h"
+#include "spdlog/async.h"
+#include "spdlog/sinks/basic_file_sink.h"
+
+#include <QByteArray>
+#include <QDebug>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+
+#ifdef Q_OS_WIN
+#   include <io.h>
+#else
+#   include <unistd.h>
+#endif
+
+namespace
+{
+    // null before init_log() and after shutdown_log(), messages are only echoed then.
+    // Only accessed through std::atomic_load() and its relatives: a thread logging holds
+    // its own reference, shutdown_log() can't destroy the logger while it is used
+    std::shared_ptr<spdlog::logger> activeLogger;
+    std::atomic<bool> echoToDebugOutput{ false };
+
+    std::terminate_handler previousTerminateHandler{ nullptr };
+
+    // only async-signal-safe calls: the logger may be in any state, it is left alone
+    // and messages still queued are lost
+    void onCrashSignal( int signal )
+    {
+        static const char message[]{ "Fatal signal, queued log messages are lost\n" };
+
+#ifdef Q_OS_WIN
+        const int written = _write( 2, message, sizeof( message ) - 1 );
+#else
+        const ssize_t written = write( STDERR_FILENO, message, sizeof( message ) - 1 );
+#endif
+        Q_UNUSED( written )
+
+        std::signal( signal, SIG_DFL );
+        std::raise( signal );
+    }
+
+    void onTerminate()
+    {
+        ::shutdown_log();
+
+        if( previousTerminateHandler != nullptr )
+        {
+            previousTerminateHandler();
+        }
+
+        std::abort();
+    }
+
+    void installShutdownHandlers()
+    {
+        static bool installed{ false };
+
+        if( installed )
+        {
+            return;
+        }
+
+        installed = true;
+
+        std::atexit( ::shutdown_log );
+        previousTerminateHandler = std::set_terminate( onTerminate );
+
+        for( const int signal : { SIGSEGV, SIGABRT, SIGFPE, SIGILL } )
+        {
+            std::signal( signal, onCrashSignal );
+        }
+    }
+
+    void log( const spdlog::level::level_enum level, const QString &message )
+    {
+        const std::shared_ptr<spdlog::logger> logger{ std::atomic_load( &activeLogger ) };
+
+        if( !logger )
+        {
+            return;
+        }
+
+        // no std::string in between, the logger copies the bytes into its own buffer
+        const QByteArray utf8{ message.toUtf8() };
+        logger->log( level, spdlog::string_view_t{ utf8.constData(), static_cast<size_t>( utf8.size() ) } );
+    }
+}
+
+LogOptions defaultLogOptions()
+{
+    LogOptions options;
+    options.mode = LogMode::ASYNCHRONOUS;
+    options.queueSize = 8192;
+    options.overflowPolicy = LogOverflowPolicy::BLOCK;
+    options.flushIntervalSeconds = 3;
+    options.echoToDebugOutput = false;
+
+    return options;
+}
+
+void init_log( const char *file )
+{
+    ::init_log( file, ::defaultLogOptions() );
+}
+
+void init_log( const char *file, const LogOptions &options )
+{
+    ::shutdown_log();
+
+    std::shared_ptr<spdlog::logger> file_logger;
+
+    if( options.mode == LogMode::ASYNCHRONOUS )
+    {
+        // one background thread writes the messages of all threads in order
+        spdlog::init_thread_pool( options.queueSize, 1 );
+
+        if( options.overflowPolicy == LogOverflowPolicy::BLOCK )
+        {
+            file_logger = spdlog::basic_logger_mt<spdlog::async_factory>( "fLog", file );
+        }
+        else
+        {
+            file_logger = spdlog::basic_logger_mt<spdlog::async_factory_nonblock>( "fLog", file );
+        }
+
+        // errors are flushed at once, everything else periodically
+        file_logger->flush_on( spdlog::level::level_enum::err );
+        spdlog::flush_every( std::chrono::seconds{ options.flushIntervalSeconds } );
+    }
+    else
+    {
+        file_logger = spdlog::basic_logger_mt( "fLog", file );
+
+        // flush every type of log level
+        file_logger->flush_on( spdlog::level::level_enum::trace );
+    }
+
+	spdlog::set_default_logger( file_logger );
+
+	spdlog::set_pattern( "[%Y-%m-%dT%H:%M:%S.%e%z] %v" );
+
+    echoToDebugOutput = options.echoToDebugOutput;
+    std::atomic_store( &activeLogger, file_logger );
+
+    installShutdownHandlers();
+}
+
+void shutdown_log()
+{
+    const std::shared_ptr<spdlog::logger> logger{ std::atomic_exchange( &activeLogger,
+                                                                        std::shared_ptr<spdlog::logger>{} ) };
+
+    if( !logger )
+    {
+        return;
+    }
+
+    // the thread pool writes all queued messages before its thread stops. A thread
+    // still logging keeps the logger alive, its message is dropped without the pool
+    logger->flush();
+    spdlog::shutdown();
+}
+
+void logError( const QString &error )
+{
+    if( echoToDebugOutput )
+    {
+        qDebug() << "Error: " << error;
+    }
+
+    log( spdlog::level::err, error );
+}
+
+void logInfo( const QString &info )
+{
+    if( echoToDebugOutput )
+    {
+        qDebug() << "Info: " << info;
+    }
+
+    log( spdlog::level::info, info );
+}
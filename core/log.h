@@ -34,7 +34,45 @@
 
 #include <QString>
 
+#include <cstddef>
+
+enum class LogMode
+{
+    // every message is written and flushed on the calling thread
+    SYNCHRONOUS,
+    // messages are queued and written by a background thread
+    ASYNCHRONOUS
+};
+
+enum class LogOverflowPolicy
+{
+    // the calling thread waits until the queue has room again
+    BLOCK,
+    // the oldest queued message is dropped, logging never waits
+    DROP_OLDEST
+};
+
+struct LogOptions
+{
+    LogMode mode;
+    // count of messages the queue of the asynchronous mode holds
+    std::size_t queueSize;
+    LogOverflowPolicy overflowPolicy;
+    // asynchronous mode only, errors are always flushed at once
+    int flushIntervalSeconds;
+    // additionally writes every message to qDebug() on the calling thread
+    bool echoToDebugOutput;
+};
+
+// asynchronous, blocking on a full queue, flushed every 3 seconds, not echoed
+LogOptions defaultLogOptions();
+
 void init_log( const char *file );
+void init_log( const char *file, const LogOptions &options );
+
+// writes all queued messages and stops the logging thread.
+// Called automatically on exit and std::terminate(), messages logged afterwards are only echoed
+void shutdown_log();
 
 void logError( const QString &error );
 void logInfo( const QString &info );
@@ -0,0 +1,131 @@
+#include "stringinterner.h"
+
+StringInterner::StringInterner()
+: stringBytes{ 0 }
+, count{ 0 }
+{
+    for( std::atomic<QString*> &chunk : this->chunks )
+    {
+        chunk.store( nullptr );
+    }
+}
+
+StringInterner::~StringInterner()
+{
+    for( std::atomic<QString*> &chunk : this->chunks )
+    {
+        delete[] chunk.load();
+    }
+}
+
+int StringInterner::intern( const QString &str )
+{
+    {
+        QReadLocker reader{ &this->lock };
+
+        auto id = this->ids.constFind( str );
+
+        if( id != this->ids.constEnd() )
+        {
+            return id.value();
+        }
+    }
+
+    QWriteLocker writer{ &this->lock };
+
+    // interned by another thread meanwhile
+    auto existing = this->ids.constFind( str );
+
+    if( existing != this->ids.constEnd() )
+    {
+        return existing.value();
+    }
+
+    const int id = this->count.load( std::memory_order_relaxed );
+
+    int chunk = 0;
+    int chunkBegin = 0;
+
+    while( id >= chunkBegin + ( firstChunkSize << chunk ) )
+    {
+        chunkBegin += firstChunkSize << chunk;
+        ++chunk;
+    }
+
+    Q_ASSERT( chunk < maxChunks );
+
+    if( this->chunks[chunk].load( std::memory_order_relaxed ) == nullptr )
+    {
+        this->chunks[chunk].store( new QString[firstChunkSize << chunk], std::memory_order_release );
+    }
+
+    this->chunks[chunk].load( std::memory_order_relaxed )[id - chunkBegin] = str;
+    this->ids.insert( str, id );
+    this->stringBytes += str.size() * 2;
+
+    this->count.store( id + 1, std::memory_order_release );
+
+    return id;
+}
+
+QVector<int> StringInterner::intern( const QVector<QString> &strings )
+{
+    QVector<int> internedIds;
+    internedIds.reserve( strings.size() );
+
+    for( const QString &str : strings )
+    {
+        internedIds.push_back( this->intern( str ) );
+    }
+
+    return internedIds;
+}
+
+QString StringInterner::string( const int id ) const
+{
+    return this->at( id );
+}
+
+QVector<QString> StringInterner::strings( const QVector<int> &ids ) const
+{
+    QVector<QString> result;
+    result.reserve( ids.size() );
+
+    for( const int id : ids )
+    {
+        result.push_back( this->at( id ) );
+    }
+
+    return result;
+}
+
+int StringInterner::size() const
+{
+    return this->count.load( std::memory_order_acquire );
+}
+
+qint64 StringInterner::memoryUsage() const
+{
+    QReadLocker reader{ &this->lock };
+
+    qint64 bytes = this->stringBytes;
+
+    // QString of the chunk, its data header and the QHash node with the key and id
+    bytes += static_cast<qint64>( this->ids.size() ) * ( sizeof( QString ) + 32 + 32 );
+
+    return bytes;
+}
+
+const QString &StringInterner::at( const int id ) const
+{
+    int chunk = 0;
+    int chunkBegin = 0;
+
+    while( id >= chunkBegin + ( firstChunkSize << chunk ) )
+    {
+        chunkBegin += firstChunkSize << chunk;
+        ++chunk;
+    }
+
+    return this->chunks[chunk].load( std::memory_order_acquire )[id - chunkBegin];
+}
@@ -0,0 +1,53 @@
+#ifndef STRINGINTERNER_H
+#define STRINGINTERNER_H
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+
+// Arena of strings with stable ids: equal strings get the same id and are stored
+// once, ids are never reused. Every analysis keeps its words and their translations
+// as ids of an interner of its own, which is freed along with the analysis, see TokenStore.
+//
+// intern() may be called from any thread. string() takes no lock: the strings
+// are stored in chunks of growing size which never move, a published id always
+// refers to the same QString.
+class StringInterner
+{
+public:
+    StringInterner();
+    ~StringInterner();
+
+    StringInterner( const StringInterner & ) = delete;
+    StringInterner &operator=( const StringInterner & ) = delete;
+
+    int intern( const QString &str );
+    QVector<int> intern( const QVector<QString> &strings );
+
+    // id has to be returned by intern() of this interner
+    QString string( const int id ) const;
+    QVector<QString> strings( const QVector<int> &ids ) const;
+
+    int size() const;
+    // estimated heap memory of the arena and its index
+    qint64 memoryUsage() const;
+
+private:
+    // chunk i holds firstChunkSize << i strings, together 2^31 - 2^10 ids
+    static const int firstChunkSize{ 1024 };
+    static const int maxChunks{ 21 };
+
+    const QString &at( const int id ) const;
+
+    mutable QReadWriteLock lock;
+    QHash<QString, int> ids;
+    qint64 stringBytes;
+
+    std::atomic<QString*> chunks[maxChunks];
+    std::atomic<int> count;
+};
+
+#endif // STRINGINTERNER_H
@@ -0,0 +1,322 @@
+#include "syntheticdata.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QVariant>
+#include <QVector>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "log.h"
+
+namespace
+{
+    // bijective base 26, every i gets its own letter sequence
+    QString letters( int i )
+    {
+        QString word;
+
+        do
+        {
+            word.prepend( QChar( 'a' + i % 26 ) );
+            i = i / 26 - 1;
+        }
+        while( i >= 0 );
+
+        return word;
+    }
+
+    bool exec( QSqlQuery &query )
+    {
+        if( !query.exec() )
+        {
+            ::logError( "SqLite error:" + query.lastError().text() );
+            return false;
+        }
+
+        return true;
+    }
+
+    // ids of the first languageCount languages, adding missing ones
+    bool selectLanguages( QSqlDatabase &db, const int languageCount,
+                          QVector<int> &langIds, QStringList &langTags )
+    {
+        QSqlQuery query( db );
+
+        if( !query.exec( "SELECT id, lang FROM languages ORDER BY id" ) )
+        {
+            ::logError( "SqLite error:" + query.lastError().text() );
+            return false;
+        }
+
+        while( query.next() && langIds.size() < languageCount )
+        {
+            langIds.push_back( query.value( 0 ).toInt() );
+            langTags.push_back( query.value( 1 ).toString() );
+        }
+
+        query.finish();
+
+        if( !query.prepare( "INSERT INTO languages(lang) VALUES(?)" ) )
+        {
+            ::logError( "SqLite error:" + query.lastError().text() );
+            return false;
+        }
+
+        for( int i = 0; langIds.size() < languageCount; ++i )
+        {
+            const QString langTag{ "x" + letters( i ) };
+
+            if( langTags.contains( langTag ) )
+            {
+                continue;
+            }
+
+            query.bindValue( 0, langTag );
+
+            if( !exec( query ) )
+            {
+                return false;
+            }
+
+            langIds.push_back( query.lastInsertId().toInt() );
+            langTags.push_back( langTag );
+        }
+
+        return true;
+    }
+
+    bool fill( QSqlDatabase &db, const SyntheticData::DictionaryOptions &options,
+               SyntheticData::DictionaryStatistics &statistics )
+    {
+        QSqlQuery query( db );
+
+        if( !query.exec( "DELETE FROM translations" ) || !query.exec( "DELETE FROM words" ) )
+        {
+            ::logError( "SqLite error:" + query.lastError().text() );
+            return false;
+        }
+
+        QVector<int> langIds;
+
+        if( !selectLanguages( db, options.languageCount, langIds, statistics.languages ) )
+        {
+            return false;
+        }
+
+        // the first two languages become the native and the foreign language
+        if( langIds.size() >= 2 )
+        {
+            if( !query.prepare( "UPDATE settings SET value = ? WHERE key = ?" ) )
+            {
+                ::logError( "SqLite error:" + query.lastError().text() );
+                return false;
+            }
+
+            query.addBindValue( QVariantList{ langIds.at( 0 ), langIds.at( 1 ) } );
+            query.addBindValue( QVariantList{ "NativeLanguageID", "ForeignLanguageID" } );
+
+            if( !query.execBatch() )
+            {
+                ::logError( "SqLite error:" + query.lastError().text() );
+                return false;
+            }
+        }
+
+        const qint64 wordsPerLanguage = options.wordsPerLanguage;
+
+        // word i of language l gets id l * wordsPerLanguage + i + 1
+        auto wordId = [wordsPerLanguage]( const int language, const int i )
+        {
+            return language * wordsPerLanguage + i + 1;
+        };
+
+        if( !query.prepare( "INSERT INTO words(id,word,lang_id) VALUES(?,?,?)" ) )
+        {
+            ::logError( "SqLite error:" + query.lastError().text() );
+            return false;
+        }
+
+        for( int language = 0; language < langIds.size(); ++language )
+        {
+            for( int i = 0; i < options.wordsPerLanguage; ++i )
+            {
+                query.bindValue( 0, wordId( language, i ) );
+                query.bindValue( 1, SyntheticData::word( i ) );
+                query.bindValue( 2, langIds.at( language ) );
+
+                if( !exec( query ) )
+                {
+                    return false;
+                }
+
+                ++statistics.words;
+            }
+        }
+
+        if( !query.prepare( "INSERT INTO translations(from_word_id,to_word_id) VALUES(?,?)" ) )
+        {
+            ::logError( "SqLite error:" + query.lastError().text() );
+            return false;
+        }
+
+        // word i is translated to the words i, i + step, i + 2 * step, ... of the other language,
+        // so every word has exactly fanOut translations in both directions
+        const int fanOut = std::min( options.fanOut, options.wordsPerLanguage );
+        const int step = std::max( 1, options.wordsPerLanguage / std::max( 1, fanOut ) );
+
+        for( int from = 0; from < langIds.size(); ++from )
+        {
+            for( int to = from + 1; to < langIds.size(); ++to )
+            {
+                for( int i = 0; i < options.wordsPerLanguage; ++i )
+                {
+                    for( int k = 0; k < fanOut; ++k )
+                    {
+                        const qint64 fromWordId = wordId( from, i );
+                        const qint64 toWordId = wordId( to, static_cast<int>( ( i + static_cast<qint64>( k ) * step )
+                                                                              % options.wordsPerLanguage ) );
+
+                        query.bindValue( 0, fromWordId );
+                        query.bindValue( 1, toWordId );
+
+                        if( !exec( query ) )
+                        {
+                            return false;
+                        }
+
+                        query.bindValue( 0, toWordId );
+                        query.bindValue( 1, fromWordId );
+
+                        if( !exec( query ) )
+                        {
+                            return false;
+                        }
+
+                        statistics.translations += 2;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+}
+
+QString SyntheticData::word( const int i )
+{
+    return letters( i );
+}
+
+QString SyntheticData::corpus( const int wordCount, const int vocabularySize,
+                               const double zipfExponent, const unsigned int seed )
+{
+    // weight of rank r is 1 / r^s
+    std::vector<double> weights;
+    weights.reserve( static_cast<size_t>( vocabularySize ) );
+
+    for( int rank = 1; rank <= vocabularySize; ++rank )
+    {
+        weights.push_back( 1.0 / std::pow( rank, zipfExponent ) );
+    }
+
+    std::mt19937 random{ seed };
+    std::discrete_distribution<int> wordIds{ weights.begin(), weights.end() };
+
+    QString text;
+    text.reserve( wordCount * 6 );
+
+    for( int i = 0; i < wordCount; ++i )
+    {
+        text.append( SyntheticData::word( wordIds( random ) ) );
+
+        if( i % 12 == 11 )
+        {
+            text.append( ".\n" );
+        }
+        else if( i % 5 == 4 )
+        {
+            text.append( ", " );
+        }
+        else
+        {
+            text.append( ' ' );
+        }
+    }
+
+    return text;
+}
+
+bool SyntheticData::createDictionary( const QString &templateDb, const QString &dbName,
+                                      const DictionaryOptions &options,
+                                      DictionaryStatistics *statistics )
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    DictionaryStatistics generated{ QStringList{}, 0, 0, 0 };
+
+    QFile::remove( dbName );
+
+    if( !QFile::copy( templateDb, dbName ) )
+    {
+        ::logError( "Could not copy " + templateDb + " to " + dbName );
+        return false;
+    }
+
+    QFile::setPermissions( dbName, QFile::ReadOwner | QFile::WriteOwner );
+
+    const QString connectionName{ "synthetic_data" };
+    bool ok = false;
+
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase( "QSQLITE", connectionName );
+        db.setDatabaseName( dbName );
+
+        if( db.open() )
+        {
+            // nobody reads the file before it is complete, a crash only loses the copy
+            QSqlQuery pragma( db );
+            pragma.exec( "PRAGMA synchronous = OFF" );
+            pragma.exec( "PRAGMA journal_mode = MEMORY" );
+            pragma.finish();
+
+            // one transaction for all rows, committing each one would take hours
+            db.transaction();
+
+            ok = fill( db, options, generated );
+
+            if( ok )
+            {
+                ok = db.commit();
+            }
+            else
+            {
+                db.rollback();
+            }
+
+            db.close();
+        }
+        else
+        {
+            ::logError( "SqLite error:" + db.lastError().text() );
+        }
+    }
+
+    QSqlDatabase::removeDatabase( connectionName );
+
+    generated.milliseconds = timer.elapsed();
+
+    if( statistics != nullptr )
+    {
+        *statistics = generated;
+    }
+
+    return ok;
+}
@@ -0,0 +1,48 @@
+#ifndef SYNTHETICDATA_H
+#define SYNTHETICDATA_H
+
+#include <QString>
+#include <QStringList>
+
+// Deterministic test data for load tests and benchmarks, written into the
+// existing languages/words/translations schema.
+//
+// Word i is the same string in every language and every run, so a corpus and
+// a dictionary generated independently from each other still share words.
+namespace SyntheticData
+{
+    struct DictionaryOptions
+    {
+        // languages taken from the template in id order, missing ones are added
+        int languageCount;
+        int wordsPerLanguage;
+        // translations of every word into every other language
+        int fanOut;
+    };
+
+    struct DictionaryStatistics
+    {
+        QStringList languages;
+        qint64 words;
+        qint64 translations;
+        qint64 milliseconds;
+    };
+
+    // word i of any language, letters only
+    QString word( const int i );
+
+    // text of wordCount words drawn from the first vocabularySize words, word i being
+    // the ( i + 1 )-th most frequent one (Zipf's law with exponent zipfExponent).
+    // Contains punctuation and a line break every few words
+    QString corpus( const int wordCount, const int vocabularySize,
+                    const double zipfExponent = 1.0, const unsigned int seed = 42 );
+
+    // copies templateDb to dbName and fills it with options.wordsPerLanguage words per language
+    // and options.fanOut translations per word and other language, in both directions.
+    // All rows are inserted in one transaction. Returns false if the database couldn't be written
+    bool createDictionary( const QString &templateDb, const QString &dbName,
+                           const DictionaryOptions &options,
+                           DictionaryStatistics *statistics = nullptr );
+}
+
+#endif // SYNTHETICDATA_H
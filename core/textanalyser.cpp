@@ -0,0 +1,119 @@
+#include "textanalyser.h"
+
+#include <QHash>
+#include <QtConcurrent>
+
+#include "dictionaryindex.h"
+
+namespace
+{
+    // below this many words to look up, starting threads costs more than it saves
+    const int parallelLookupThreshold{ 4096 };
+}
+
+QVector<QChar> TextAnalyser::defaultWordSeperators()
+{
+    // TODO: initialise this vector from database!
+    return QVector<QChar>{ '-', L'´', '`', L'’', '\'' };   // EXAMPLE
+}
+
+TextAnalyser::TextAnalyser( const QVector<QChar> &wordSeperators )
+: tokenizer{ wordSeperators }
+{
+}
+
+bool TextAnalyser::tokenise( const QString &text, TokenStore &foreign_words,
+                             const ProgressCallback &progress ) const
+{
+    return this->tokenizer.tokenise( text, foreign_words,
+        [&progress]( const int done, const int total )
+        {
+            return !progress || progress( "Tokenising", done, total );
+        } );
+}
+
+bool TextAnalyser::buildTranslationStructure( TokenStore &foreign_words,
+                                              const DictionaryIndex &dictionaryIndex,
+                                              TranslationCache &cachedTranslations,
+                                              const ProgressCallback &progress ) const
+{
+    foreign_words.clearWordTypes();
+
+    // 1. distinct words, found by the slices of the text, every word gets its word type
+    QHash<QStringRef, int> typeIds;
+    QVector<QString> types;
+
+    for( int i = 0; i < foreign_words.size(); ++i )
+    {
+        if( progress && ( i & 0xFFFF ) == 0 && !progress( "Collecting words", i, foreign_words.size() ) )
+        {
+            return false;
+        }
+
+        if( foreign_words.isWordType( i ) )
+        {
+            const QStringRef content{ foreign_words.content( i ) };
+
+            auto typeId = typeIds.constFind( content );
+
+            if( typeId == typeIds.constEnd() )
+            {
+                types.push_back( content.toString() );
+                typeId = typeIds.insert( content, foreign_words.addWordType( types.last() ) );
+            }
+
+            foreign_words.setWordType( i, typeId.value() );
+        }
+    }
+
+    // 2. every distinct word is resolved once, the cache first
+    QVector<QVector<QString>> typeTranslations( types.size() );
+    QVector<int> missingTypes;
+
+    for( int typeId = 0; typeId < types.size(); ++typeId )
+    {
+        if( !cachedTranslations.find( types.at( typeId ), typeTranslations[typeId] ) )
+        {
+            missingTypes.push_back( typeId );
+        }
+    }
+
+    if( progress && !progress( "Looking up translations", 0, missingTypes.size() ) )
+    {
+        return false;
+    }
+
+    // the index is only read and every word writes its own slot,
+    // large vocabularies are looked up on all cores
+    QVector<QString> *results = typeTranslations.data();
+
+    auto lookup = [&dictionaryIndex, &types, results]( const int typeId )
+    {
+        results[typeId] = dictionaryIndex.getTranslations( types.at( typeId ) );
+    };
+
+    if( missingTypes.size() >= parallelLookupThreshold )
+    {
+        QtConcurrent::blockingMap( missingTypes, lookup );
+    }
+    else
+    {
+        for( const int typeId : missingTypes )
+        {
+            lookup( typeId );
+        }
+    }
+
+    for( const int typeId : missingTypes )
+    {
+        cachedTranslations.insert( types.at( typeId ), typeTranslations.at( typeId ) );
+    }
+
+    // 3. the translations belong to the word type, no token has to be touched again
+    for( int typeId = 0; typeId < types.size(); ++typeId )
+    {
+        foreign_words.setTranslations( typeId, typeTranslations.at( typeId ) );
+    }
+
+    return true;
+}
@@ -0,0 +1,47 @@
+#ifndef TEXTANALYSER_H
+#define TEXTANALYSER_H
+
+#include <QChar>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+#include "tokenizer.h"
+#include "tokenstore.h"
+#include "translationcache.h"
+
+// Forward-Declarations
+class DictionaryIndex;
+
+// The part of the analysis which doesn't need any widget: splits a text into
+// words and links and resolves the translations of the words.
+// Shared by AnalyseJob and the headless batch mode.
+class TextAnalyser
+{
+public:
+    // called with ( stage, done, total ), returning false aborts
+    using ProgressCallback = std::function<bool( const QString &, const int, const int )>;
+
+    // characters, which are part of a word although they are no letters
+    static QVector<QChar> defaultWordSeperators();
+
+    explicit TextAnalyser( const QVector<QChar> &wordSeperators );
+
+    // replaces foreign_words by the tokens of text, returns false if aborted
+    bool tokenise( const QString &text, TokenStore &foreign_words,
+                   const ProgressCallback &progress = ProgressCallback{} ) const;
+
+    // assigns a word type to every word of foreign_words and sets the translations of
+    // every word type. Every distinct word is resolved only once, by cachedTranslations
+    // or the index, which extends the cache. Returns false if aborted
+    bool buildTranslationStructure( TokenStore &foreign_words,
+                                    const DictionaryIndex &dictionaryIndex,
+                                    TranslationCache &cachedTranslations,
+                                    const ProgressCallback &progress = ProgressCallback{} ) const;
+
+private:
+    Tokenizer tokenizer;
+};
+
+#endif // TEXTANALYSER_H
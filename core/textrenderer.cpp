@@ -0,0 +1,406 @@
+#include "textrenderer.h"
+
+#include <QColor>
+#include <QFontMetrics>
+#include <QTextCursor>
+#include <QTextDocument>
+
+#include <algorithm>
+
+namespace
+{
+    const QChar unicodeLine{ 0x23AF }; // 0x23AF = '⎯'
+}
+
+TextRenderer::TextRenderer( const QFont &font, const QMap<TextTypeColor, QString> &textColors )
+: font{ font }
+, formats( 6 )
+, layout{}
+, knownWords{ 0 }
+, unknownWords{ 0 }
+{
+    this->formats[static_cast<int>( Format::FOREIGN_KNOWN )].setForeground(
+                QColor{ textColors.value( TextTypeColor::FOREIGN_TEXT_KNOWN_COLOR ) } );
+
+    this->formats[static_cast<int>( Format::FOREIGN_UNKNOWN )].setForeground(
+                QColor{ textColors.value( TextTypeColor::FOREIGN_TEXT_UNKNOWN_COLOR ) } );
+
+    // translations are bold
+    this->formats[static_cast<int>( Format::NATIVE_WORD )].setFontWeight( QFont::Bold );
+    this->formats[static_cast<int>( Format::NATIVE_WORD )].setForeground(
+                QColor{ textColors.value( TextTypeColor::NATIVE_UNMARKED_TEXT_COLOR ) } );
+
+    this->formats[static_cast<int>( Format::NATIVE_LINK )].setFontWeight( QFont::Bold );
+
+    this->formats[static_cast<int>( Format::HORIZONTAL_LINE )].setForeground(
+                QColor{ textColors.value( TextTypeColor::HORIZONTAL_LINE_COLOR ) } );
+}
+
+const QTextCharFormat &TextRenderer::getFormat( const Format format ) const
+{
+    return this->formats.at( static_cast<int>( format ) );
+}
+
+const TextLayout &TextRenderer::getLayout() const
+{
+    return this->layout;
+}
+
+int TextRenderer::getKnownWords() const
+{
+    return this->knownWords;
+}
+
+int TextRenderer::getUnknownWords() const
+{
+    return this->unknownWords;
+}
+
+QTextDocument *TextRenderer::render( const TokenStore &foreign_words,
+                                     const ProgressCallback &progress )
+{
+    this->buildLayout( foreign_words );
+
+    const int lineCount = this->layout.lineFirstToken.size();
+
+    QVector<RenderedLine> renderedLines;
+    renderedLines.reserve( lineCount );
+
+    // report progress about every percent, rendering and inserting count half each
+    const int progressStep = std::max( 1, lineCount / 50 );
+
+    for( int line = 0; line < lineCount; ++line )
+    {
+        if( progress && line % progressStep == 0 && !progress( line, 2 * lineCount ) )
+        {
+            return nullptr;
+        }
+
+        renderedLines.push_back( this->renderLine( foreign_words, this->layout, line ) );
+
+        this->layout.textEditViewWidth = std::max( this->layout.textEditViewWidth,
+                                                   renderedLines.last().width );
+    }
+
+    QFontMetrics fm{ this->font };
+    const int maxCharWidth{ fm.width( unicodeLine ) };
+
+    // text available, no empty lines, horizontalLineLength can be set
+    if( this->layout.textEditViewWidth > 0 )
+    {
+       this->layout.horizontalLineLength = static_cast<int>( this->layout.textEditViewWidth / maxCharWidth ) + 1;
+    }
+
+    QTextDocument *document = new QTextDocument;
+    document->setDefaultFont( this->font );
+    document->setUndoRedoEnabled( false );
+
+    QTextCursor cursor{ document };
+    cursor.beginEditBlock();
+
+    for( int line = 0; line < lineCount; ++line )
+    {
+        if( progress && line % progressStep == 0 && !progress( lineCount + line, 2 * lineCount ) )
+        {
+            cursor.endEditBlock();
+            delete document;
+            return nullptr;
+        }
+
+        this->insertLine( cursor,
+                          renderedLines.at( line ),
+                          line == lineCount - 1,
+                          this->layout.horizontalLineLength,
+                          this->layout.lineDocumentLength[line] );
+    }
+
+    cursor.endEditBlock();
+    document->setUndoRedoEnabled( true );
+
+    return document;
+}
+
+bool TextRenderer::renderLinePair( QTextCursor &cursor, const TokenStore &foreign_words,
+                                   TextLayout &layout, const int line ) const
+{
+    const RenderedLine renderedLine{ this->renderLine( foreign_words, layout, line ) };
+
+    if( renderedLine.width > layout.textEditViewWidth )
+    {
+        return false;
+    }
+
+    cursor.removeSelectedText();
+
+    this->insertLine( cursor,
+                      renderedLine,
+                      line == layout.lineFirstToken.size() - 1,
+                      layout.horizontalLineLength,
+                      layout.lineDocumentLength[line] );
+
+    return true;
+}
+
+void TextRenderer::buildLayout( const TokenStore &foreign_words )
+{
+    this->layout = TextLayout{};
+    this->layout.textEditViewWidth = 0;
+    this->layout.horizontalLineLength = 0;
+    this->layout.tokenLines.reserve( foreign_words.size() );
+
+    this->knownWords = 0;
+    this->unknownWords = 0;
+
+    this->layout.lineFirstToken.push_back( 0 );
+    this->layout.lineFirstTokenOffset.push_back( 0 );
+
+    // tokens of every word type, turned into occurrences once all tokens are seen.
+    // They are counted first, so every list is allocated once instead of growing per token
+    QVector<int> typeTokenCounts( foreign_words.wordTypeCount(), 0 );
+
+    for( int i = 0; i < foreign_words.size(); ++i )
+    {
+        if( foreign_words.wordType( i ) >= 0 )
+        {
+            ++typeTokenCounts[foreign_words.wordType( i )];
+        }
+    }
+
+    QVector<QVector<int>> typeOccurrences( foreign_words.wordTypeCount() );
+
+    for( int wordType = 0; wordType < typeOccurrences.size(); ++wordType )
+    {
+        typeOccurrences[wordType].reserve( typeTokenCounts.at( wordType ) );
+    }
+
+    for( int i = 0; i < foreign_words.size(); ++i )
+    {
+        this->layout.tokenLines.push_back( this->layout.lineFirstToken.size() - 1 );
+
+        if( foreign_words.isWordType( i ) )
+        {
+            if( foreign_words.wordType( i ) >= 0 )
+            {
+                typeOccurrences[foreign_words.wordType( i )].push_back( i );
+            }
+
+            if( foreign_words.hasTranslations( i ) )
+            {
+                ++this->knownWords;
+            }
+            else
+            {
+                ++this->unknownWords;
+            }
+        }
+        else
+        {
+            const QStringRef content{ foreign_words.content( i ) };
+
+            // the offset is one of the padded link, see paddedLink()
+            for( int newLine = content.indexOf( '\n' ); newLine >= 0; newLine = content.indexOf( '\n', newLine + 1 ) )
+            {
+                this->layout.lineFirstToken.push_back( i );
+                this->layout.lineFirstTokenOffset.push_back( newLine + 2 );
+            }
+        }
+    }
+
+    this->layout.occurrences.reserve( typeOccurrences.size() );
+
+    for( int wordType = 0; wordType < typeOccurrences.size(); ++wordType )
+    {
+        this->layout.occurrences.insert( foreign_words.wordTypeContent( wordType ), typeOccurrences.at( wordType ) );
+    }
+
+    this->layout.lineDocumentLength.fill( 0, this->layout.lineFirstToken.size() );
+}
+
+TextRenderer::RenderedLine TextRenderer::renderLine( const TokenStore &foreign_words,
+                                                     const TextLayout &layout,
+                                                     const int line ) const
+{
+    RenderedLine renderedLine{ QVector<Fragment>{}, QVector<Fragment>{}, 0, 0, 0, QVector<int>{}, QVector<int>{} };
+
+    QString cleanForeignTextLine;
+    QString cleanNativeTextLine;
+
+    int offset = layout.lineFirstTokenOffset.at( line );
+
+    for( int i = layout.lineFirstToken.at( line ); i < foreign_words.size(); ++i, offset = 0 )
+    {
+        if( foreign_words.isWordType( i ) )
+        {
+            const QString content{ foreign_words.content( i ).toString() };
+            const int wordLength = content.size();
+            const QVector<int> translationIds = foreign_words.getTranslationIds( i );
+
+            renderedLine.wordTokens.push_back( i );
+            renderedLine.wordColumns.push_back( renderedLine.foreignLength );
+
+            cleanForeignTextLine.append( content );
+            this->appendFragment( renderedLine.foreignFragments, content,
+                                  translationIds.isEmpty() ? Format::FOREIGN_UNKNOWN : Format::FOREIGN_KNOWN );
+
+            int columnLength = wordLength;
+
+            if( !translationIds.isEmpty() )
+            {
+                const QString bestTranslation = foreign_words.string( translationIds.at( 0 ) );
+                cleanNativeTextLine.append( bestTranslation );
+
+                QString nativeText{ this->maskText( bestTranslation ) };
+                const int translationLength = this->maskedLength( bestTranslation );
+
+                if( translationLength < wordLength )
+                {
+                    cleanNativeTextLine.append( QString{ wordLength - translationLength, ' ' } );
+                    nativeText.append( QString{ wordLength - translationLength, QChar::Nbsp } );
+                }
+                else if( translationLength > wordLength )
+                {
+                    cleanForeignTextLine.append( QString{ translationLength - wordLength, ' ' } );
+                    this->appendFragment( renderedLine.foreignFragments,
+                                          QString{ translationLength - wordLength, QChar::Nbsp },
+                                          Format::FOREIGN_LINK );
+                    columnLength = translationLength;
+                }
+
+                this->appendFragment( renderedLine.nativeFragments, nativeText, Format::NATIVE_WORD );
+            }
+            else
+            {
+                this->appendFragment( renderedLine.nativeFragments,
+                                      QString{ wordLength, QChar::Nbsp },
+                                      Format::NATIVE_WORD );
+            }
+
+            renderedLine.foreignLength += columnLength;
+            renderedLine.nativeLength += columnLength;
+        }
+        else
+        {
+            const QString content{ TextRenderer::paddedLink( foreign_words.content( i ) ) };
+            const int newLine = content.indexOf( '\n', offset );
+            const QString part{ content.mid( offset, ( newLine < 0 ) ? -1 : newLine - offset ) };
+
+            const QString maskedContent = this->maskText( part );
+
+            cleanForeignTextLine.append( part );
+            cleanNativeTextLine.append( part );
+
+            this->appendFragment( renderedLine.foreignFragments, maskedContent, Format::FOREIGN_LINK );
+            this->appendFragment( renderedLine.nativeFragments, maskedContent, Format::NATIVE_LINK );
+            renderedLine.foreignLength += maskedContent.size();
+            renderedLine.nativeLength += maskedContent.size();
+
+            if( newLine >= 0 )
+            {
+                break;
+            }
+        }
+    }
+
+    QFontMetrics fm{ this->font };
+
+    renderedLine.width = std::max( fm.width( cleanForeignTextLine ), fm.width( cleanNativeTextLine ) );
+
+    return renderedLine;
+}
+
+void TextRenderer::insertLine( QTextCursor &cursor, const RenderedLine &renderedLine, const bool isLastLine,
+                               const int horizontalLineLength, int &documentLength ) const
+{
+    const QString lineSeparator{ QChar::LineSeparator };
+
+    for( const Fragment &fragment : renderedLine.foreignFragments )
+    {
+        cursor.insertText( fragment.text, this->formats.at( static_cast<int>( fragment.format ) ) );
+    }
+
+    cursor.insertText( lineSeparator, this->formats.at( static_cast<int>( Format::FOREIGN_LINK ) ) );
+
+    for( const Fragment &fragment : renderedLine.nativeFragments )
+    {
+        cursor.insertText( fragment.text, this->formats.at( static_cast<int>( fragment.format ) ) );
+    }
+
+    documentLength = renderedLine.foreignLength + 1 + renderedLine.nativeLength;
+
+    if( !isLastLine )
+    {
+        const QTextCharFormat &format = this->formats.at( static_cast<int>( Format::HORIZONTAL_LINE ) );
+
+        cursor.insertText( lineSeparator, format );
+        cursor.insertText( QString{ horizontalLineLength, unicodeLine }, format );
+        cursor.insertText( lineSeparator, format );
+
+        documentLength += 1 + horizontalLineLength + 1;
+    }
+}
+
+// merges text into the last fragment if both share the same format
+void TextRenderer::appendFragment( QVector<Fragment> &fragments, const QString &text, const Format format ) const
+{
+    if( text.isEmpty() )
+    {
+        return;
+    }
+
+    if( !fragments.isEmpty() && fragments.last().format == format )
+    {
+        fragments.last().text.append( text );
+    }
+    else
+    {
+        fragments.push_back( Fragment{ text, format } );
+    }
+}
+
+// links are shown with a space on both sides, so words never touch their neighbours
+QString TextRenderer::paddedLink( const QStringRef &link )
+{
+    if( link.isEmpty() )
+    {
+        return QString{};
+    }
+
+    QString padded;
+    padded.reserve( link.size() + 2 );
+    padded.append( ' ' );
+    padded.append( link );
+    padded.append( ' ' );
+
+    return padded;
+}
+
+// white space is shown as non-breaking space, tabs as four of them
+QString TextRenderer::maskText( const QString &content ) const
+{
+    QString maskedText;
+    maskedText.reserve( this->maskedLength( content ) );
+
+    for( const QChar &ch : content )
+    {
+        if( ch == '\t' )
+        {
+            maskedText.append( QString{ 4, QChar::Nbsp } );
+        }
+        else if( ch.isSpace() )
+        {
+            maskedText.append( QChar::Nbsp );
+        }
+        else
+        {
+            maskedText.append( ch );
+        }
+    }
+
+    return maskedText;
+}
+
+// count of characters maskText( content ) becomes
+int TextRenderer::maskedLength( const QString &content ) const
+{
+    return content.size() + 3 * content.count( '\t' );
+}
@@ -0,0 +1,133 @@
+#ifndef TEXTRENDERER_H
+#define TEXTRENDERER_H
+
+#include <QFont>
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QTextCharFormat>
+#include <QVector>
+
+#include <functional>
+
+#include "tokenstore.h"
+
+// Forward-Declarations
+class QTextCursor;
+class QTextDocument;
+
+enum class TextTypeColor
+{
+    FOREIGN_TEXT_KNOWN_COLOR,
+    FOREIGN_TEXT_UNKNOWN_COLOR,
+    STATISTIC_KNOWN_WORDS_COLOR,
+    STATISTIC_UNKNOWN_WORDS_COLOR,
+    HORIZONTAL_LINE_COLOR,
+    SEPERATOR_COLOR,
+    NATIVE_MARKED_TEXT_COLOR,
+    NATIVE_UNMARKED_TEXT_COLOR
+};
+
+// Where the rendered lines and words are, so single lines can be rendered again later.
+// A line pair is the foreign line, the native line below and the horizontal line.
+struct TextLayout
+{
+    // first token of every line and the offset inside of it,
+    // a line can start inside of a link containing '\n'
+    QVector<int> lineFirstToken;
+    QVector<int> lineFirstTokenOffset;
+
+    // count of characters of every line pair in the document
+    QVector<int> lineDocumentLength;
+
+    // line of every token, a link spanning lines belongs to the line it starts in
+    QVector<int> tokenLines;
+
+    // word -> indexes of all tokens of that word
+    QHash<QString, QVector<int>> occurrences;
+
+    // widest line in pixels and the length of the horizontal line built from it
+    int textEditViewWidth;
+    int horizontalLineLength;
+};
+
+// Writes the interleaved foreign/native view of an analysed text into a QTextDocument,
+// using one prepared QTextCharFormat per kind of text.
+// Doesn't touch any widget, so it can run on a worker thread.
+class TextRenderer
+{
+public:
+    // called with ( rendered lines, all lines ), returning false aborts rendering
+    using ProgressCallback = std::function<bool( const int, const int )>;
+
+    enum class Format
+    {
+        FOREIGN_KNOWN,
+        FOREIGN_UNKNOWN,
+        FOREIGN_LINK,
+        NATIVE_WORD,
+        NATIVE_LINK,
+        HORIZONTAL_LINE
+    };
+
+    // run of text sharing one format
+    struct Fragment
+    {
+        QString text;
+        Format format;
+    };
+
+    // one line pair, not inserted into any document yet
+    struct RenderedLine
+    {
+        QVector<Fragment> foreignFragments;
+        QVector<Fragment> nativeFragments;
+        int foreignLength;
+        int nativeLength;
+        int width;
+
+        // word tokens of the line and the column of the foreign line each one starts at
+        QVector<int> wordTokens;
+        QVector<int> wordColumns;
+    };
+
+    explicit TextRenderer( const QFont &font, const QMap<TextTypeColor, QString> &textColors );
+
+    // returns a new document owned by the caller, nullptr if aborted
+    QTextDocument *render( const TokenStore &foreign_words,
+                           const ProgressCallback &progress = ProgressCallback{} );
+
+    // renders line pair line of an already rendered text again, replacing the selection of cursor.
+    // Returns false without touching the document if the line got wider than the
+    // horizontal lines, then the whole text has to be rendered again
+    bool renderLinePair( QTextCursor &cursor, const TokenStore &foreign_words,
+                         TextLayout &layout, const int line ) const;
+
+    // only builds the layout and counts the words, without rendering a single line.
+    // Used by views, which render the visible lines themselves with renderLine()
+    void buildLayout( const TokenStore &foreign_words );
+
+    RenderedLine renderLine( const TokenStore &foreign_words, const TextLayout &layout, const int line ) const;
+
+    const QTextCharFormat &getFormat( const Format format ) const;
+    const TextLayout &getLayout() const;
+    int getKnownWords() const;
+    int getUnknownWords() const;
+
+private:
+    void insertLine( QTextCursor &cursor, const RenderedLine &renderedLine, const bool isLastLine,
+                     const int horizontalLineLength, int &documentLength ) const;
+    void appendFragment( QVector<Fragment> &fragments, const QString &text, const Format format ) const;
+    QString maskText( const QString &content ) const;
+    static QString paddedLink( const QStringRef &link );
+    int maskedLength( const QString &content ) const;
+
+    QFont font;
+    // indexed by Format
+    QVector<QTextCharFormat> formats;
+    TextLayout layout;
+    int knownWords;
+    int unknownWords;
+};
+
+#endif // TEXTRENDERER_H
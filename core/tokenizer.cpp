@@ -0,0 +1,289 @@
+#include "tokenizer.h"
+
+#include <QtAlgorithms>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#   define TOKENIZER_SSE2
+#   include <immintrin.h>
+#   if defined( _MSC_VER )
+#       include <intrin.h>
+#       define TOKENIZER_AVX2
+#       define TOKENIZER_TARGET_AVX2
+#   elif defined( __GNUC__ )
+#       define TOKENIZER_AVX2
+#       define TOKENIZER_TARGET_AVX2 __attribute__(( target( "avx2" ) ))
+#   endif
+#endif
+
+namespace
+{
+    const int bmpSize = 0x10000;
+
+#ifdef TOKENIZER_SSE2
+    // one bit per code unit of the 8 units at units, set for word characters.
+    // Returns -1 if the block isn't pure ASCII.
+    int classifyBlockSse2( const ushort *units, const QVector<ushort> &asciiWordSeperators )
+    {
+        const __m128i block = _mm_loadu_si128( reinterpret_cast<const __m128i*>( units ) );
+        const __m128i nonAscii = _mm_and_si128( block, _mm_set1_epi16( static_cast<short>( 0xFF80 ) ) );
+
+        if( _mm_movemask_epi8( _mm_cmpeq_epi16( nonAscii, _mm_setzero_si128() ) ) != 0xFFFF )
+        {
+            return -1;
+        }
+
+        // 'A'..'Z' | 0x20 == 'a'..'z', no other ASCII character gets mapped there
+        const __m128i lower = _mm_or_si128( block, _mm_set1_epi16( 0x20 ) );
+
+        __m128i word = _mm_and_si128( _mm_cmpgt_epi16( lower, _mm_set1_epi16( 'a' - 1 ) ),
+                                      _mm_cmplt_epi16( lower, _mm_set1_epi16( 'z' + 1 ) ) );
+
+        for( const ushort seperator : asciiWordSeperators )
+        {
+            word = _mm_or_si128( word, _mm_cmpeq_epi16( block, _mm_set1_epi16( static_cast<short>( seperator ) ) ) );
+        }
+
+        return _mm_movemask_epi8( _mm_packs_epi16( word, _mm_setzero_si128() ) ) & 0xFF;
+    }
+#endif
+
+#ifdef TOKENIZER_AVX2
+    // same as classifyBlockSse2(), for 16 units
+    TOKENIZER_TARGET_AVX2
+    int classifyBlockAvx2( const ushort *units, const QVector<ushort> &asciiWordSeperators )
+    {
+        const __m256i block = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( units ) );
+
+        if( !_mm256_testz_si256( block, _mm256_set1_epi16( static_cast<short>( 0xFF80 ) ) ) )
+        {
+            return -1;
+        }
+
+        const __m256i lower = _mm256_or_si256( block, _mm256_set1_epi16( 0x20 ) );
+
+        __m256i word = _mm256_and_si256( _mm256_cmpgt_epi16( lower, _mm256_set1_epi16( 'a' - 1 ) ),
+                                         _mm256_cmpgt_epi16( _mm256_set1_epi16( 'z' + 1 ), lower ) );
+
+        for( const ushort seperator : asciiWordSeperators )
+        {
+            word = _mm256_or_si256( word, _mm256_cmpeq_epi16( block, _mm256_set1_epi16( static_cast<short>( seperator ) ) ) );
+        }
+
+        // packs works per 128 bit lane, the permutation moves both packed halves next to each other
+        const __m256i packed = _mm256_permute4x64_epi64( _mm256_packs_epi16( word, _mm256_setzero_si256() ), 0xD8 );
+
+        return _mm256_movemask_epi8( packed ) & 0xFFFF;
+    }
+#endif
+
+    bool cpuSupportsAvx2()
+    {
+#if defined( TOKENIZER_AVX2 ) && defined( _MSC_VER )
+        int info[4];
+
+        __cpuid( info, 0 );
+
+        if( info[0] < 7 )
+        {
+            return false;
+        }
+
+        // the OS has to save the YMM registers as well
+        __cpuid( info, 1 );
+
+        const bool osxsave = ( info[2] & ( 1 << 27 ) ) != 0;
+        const bool avx = ( info[2] & ( 1 << 28 ) ) != 0;
+
+        if( !osxsave || !avx || ( _xgetbv( 0 ) & 6 ) != 6 )
+        {
+            return false;
+        }
+
+        __cpuidex( info, 7, 0 );
+
+        return ( info[1] & ( 1 << 5 ) ) != 0;
+#elif defined( TOKENIZER_AVX2 )
+        __builtin_cpu_init();
+
+        return __builtin_cpu_supports( "avx2" );
+#else
+        return false;
+#endif
+    }
+}
+
+Tokenizer::InstructionSet Tokenizer::detectInstructionSet()
+{
+#ifdef TOKENIZER_SSE2
+    static const InstructionSet detected = cpuSupportsAvx2() ? InstructionSet::AVX2
+                                                             : InstructionSet::SSE2;
+    return detected;
+#else
+    return InstructionSet::SCALAR;
+#endif
+}
+
+Tokenizer::Tokenizer( const QVector<QChar> &wordSeperators, const InstructionSet instructionSet )
+: bmpWordBits( bmpSize / 64, 0 )
+, instructionSet{ instructionSet }
+{
+    for( int unit = 0; unit < bmpSize; ++unit )
+    {
+        const QChar ch{ static_cast<ushort>( unit ) };
+
+        if( ch.isLetter() || wordSeperators.contains( ch ) )
+        {
+            this->bmpWordBits[unit >> 6] |= quint64{ 1 } << ( unit & 63 );
+        }
+    }
+
+    for( const QChar &seperator : wordSeperators )
+    {
+        if( seperator.unicode() < 0x80 && !this->asciiWordSeperators.contains( seperator.unicode() ) )
+        {
+            this->asciiWordSeperators.push_back( seperator.unicode() );
+        }
+    }
+
+#ifndef TOKENIZER_SSE2
+    this->instructionSet = InstructionSet::SCALAR;
+#endif
+}
+
+Tokenizer::InstructionSet Tokenizer::getInstructionSet() const
+{
+    return this->instructionSet;
+}
+
+bool Tokenizer::isWordCharacter( const QChar &ch ) const
+{
+    const ushort unit = ch.unicode();
+
+    return ( this->bmpWordBits.at( unit >> 6 ) >> ( unit & 63 ) ) & 1;
+}
+
+bool Tokenizer::isWordCodePoint( const uint codePoint ) const
+{
+    if( codePoint < static_cast<uint>( bmpSize ) )
+    {
+        return this->isWordCharacter( QChar{ static_cast<ushort>( codePoint ) } );
+    }
+
+    return QChar::isLetter( codePoint );
+}
+
+int Tokenizer::wordCharacterLength( const QString &text, const int position ) const
+{
+    const QChar ch{ text.at( position ) };
+
+    if( ch.isHighSurrogate() && position + 1 < text.size() && text.at( position + 1 ).isLowSurrogate() )
+    {
+        const uint codePoint = QChar::surrogateToUcs4( ch, text.at( position + 1 ) );
+
+        return QChar::isLetter( codePoint ) ? 2 : 0;
+    }
+
+    return this->isWordCharacter( ch ) ? 1 : 0;
+}
+
+bool Tokenizer::tokenise( const QString &text, TokenStore &tokens, const ProgressCallback &progress ) const
+{
+    tokens = TokenStore{ text };
+
+    if( text.isEmpty() )
+    {
+        return true;
+    }
+
+    // rough guess: words and links alternate, average word length about 5
+    tokens.reserve( text.size() / 3 );
+
+    const ushort *units = text.utf16();
+    const int size = text.size();
+
+#ifndef TOKENIZER_SSE2
+    Q_UNUSED( units )
+#endif
+
+    int tokenStart = 0;
+    bool inWord = this->wordCharacterLength( text, 0 ) > 0;
+    int nextProgress = 0;
+
+    // emits a token at every class change inside a classified block of blockSize units at position
+    auto splitBlock = [&]( const int position, const quint32 wordMask, const int blockSize )
+    {
+        // bit i of previousMask is the class of unit i-1
+        const quint32 previousMask = ( wordMask << 1 ) | ( inWord ? 1u : 0u );
+        quint32 changes = ( wordMask ^ previousMask ) & ( ( 1u << blockSize ) - 1 );
+
+        while( changes != 0 )
+        {
+            const int tokenEnd = position + static_cast<int>( qCountTrailingZeroBits( changes ) );
+
+            tokens.append( tokenStart, tokenEnd - tokenStart, inWord ? TYPE::WORD : TYPE::LINK );
+            tokenStart = tokenEnd;
+            inWord = !inWord;
+
+            changes &= changes - 1;
+        }
+    };
+
+    for( int i = 0; i < size; )
+    {
+        if( i >= nextProgress )
+        {
+            if( progress && !progress( i, size ) )
+            {
+                tokens = TokenStore{};
+                return false;
+            }
+
+            nextProgress = i + 0x10000;
+        }
+
+#ifdef TOKENIZER_AVX2
+        if( this->instructionSet == InstructionSet::AVX2 && i + 16 <= size )
+        {
+            const int wordMask = classifyBlockAvx2( units + i, this->asciiWordSeperators );
+
+            if( wordMask >= 0 )
+            {
+                splitBlock( i, static_cast<quint32>( wordMask ), 16 );
+                i += 16;
+                continue;
+            }
+        }
+#endif
+
+#ifdef TOKENIZER_SSE2
+        if( this->instructionSet != InstructionSet::SCALAR && i + 8 <= size )
+        {
+            const int wordMask = classifyBlockSse2( units + i, this->asciiWordSeperators );
+
+            if( wordMask >= 0 )
+            {
+                splitBlock( i, static_cast<quint32>( wordMask ), 8 );
+                i += 8;
+                continue;
+            }
+        }
+#endif
+
+        // non-ASCII or tail: one character at a time
+        const int wordCharLength = this->wordCharacterLength( text, i );
+        const bool isWordChar = wordCharLength > 0;
+
+        if( isWordChar != inWord )
+        {
+            tokens.append( tokenStart, i - tokenStart, inWord ? TYPE::WORD : TYPE::LINK );
+            tokenStart = i;
+            inWord = isWordChar;
+        }
+
+        i += isWordChar ? wordCharLength : 1;
+    }
+
+    tokens.append( tokenStart, size - tokenStart, inWord ? TYPE::WORD : TYPE::LINK );
+
+    return true;
+}
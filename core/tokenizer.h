@@ -0,0 +1,60 @@
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+#include "tokenstore.h"
+
+// Splits a text into words and the links between them.
+//
+// Whether a code unit belongs to a word is looked up in a bitmap covering the
+// whole BMP, which is built once from QChar::isLetter() and the word
+// seperators. Code points outside the BMP (surrogate pairs) fall back to
+// QChar::isLetter( uint ); word seperators are always part of the BMP.
+//
+// On x86 pure ASCII blocks of 8 (SSE2) or 16 (AVX2) code units are classified
+// at once, the instruction set is picked at runtime.
+class Tokenizer
+{
+public:
+    enum class InstructionSet
+    {
+        SCALAR,
+        SSE2,
+        AVX2
+    };
+
+    // called with ( tokenised code units, all code units ), returning false aborts
+    using ProgressCallback = std::function<bool( const int, const int )>;
+
+    // best instruction set supported by this machine
+    static InstructionSet detectInstructionSet();
+
+    explicit Tokenizer( const QVector<QChar> &wordSeperators,
+                        const InstructionSet instructionSet = Tokenizer::detectInstructionSet() );
+
+    InstructionSet getInstructionSet() const;
+
+    bool isWordCharacter( const QChar &ch ) const;
+    bool isWordCodePoint( const uint codePoint ) const;
+
+    // replaces tokens by slices of text, nothing is copied. Returns false if aborted
+    bool tokenise( const QString &text, TokenStore &tokens,
+                   const ProgressCallback &progress = ProgressCallback{} ) const;
+
+private:
+    // returns the count of code units of the word character at position, 0 if it's no word character
+    int wordCharacterLength( const QString &text, const int position ) const;
+
+    // one bit per BMP code unit
+    QVector<quint64> bmpWordBits;
+
+    // word seperators, which are part of ASCII, for the vectorised path
+    QVector<ushort> asciiWordSeperators;
+    InstructionSet instructionSet;
+};
+
+#endif // TOKENIZER_H
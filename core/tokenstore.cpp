@@ -0,0 +1,169 @@
+#include "tokenstore.h"
+
+#include "stringinterner.h"
+
+namespace
+{
+    // QArrayData header plus the allocation granularity of a vector
+    const qint64 allocationOverhead{ 32 };
+
+    template<typename T>
+    qint64 vectorCost( const QVector<T> &vector )
+    {
+        return ( vector.capacity() > 0 ) ? allocationOverhead + vector.capacity() * static_cast<qint64>( sizeof( T ) )
+                                         : 0;
+    }
+}
+
+TokenStore::TokenStore()
+: TokenStore{ QString{} }
+{
+}
+
+TokenStore::TokenStore( const QString &text )
+: text{ text }
+, interner{ new StringInterner }
+{
+}
+
+const QString &TokenStore::getText() const
+{
+    return this->text;
+}
+
+int TokenStore::size() const
+{
+    return this->offsets.size();
+}
+
+bool TokenStore::isEmpty() const
+{
+    return this->offsets.isEmpty();
+}
+
+void TokenStore::reserve( const int count )
+{
+    this->offsets.reserve( count );
+    this->lengths.reserve( count );
+    this->types.reserve( count );
+    this->wordTypes.reserve( count );
+}
+
+void TokenStore::append( const int offset, const int length, const TYPE type )
+{
+    this->offsets.push_back( offset );
+    this->lengths.push_back( length );
+    this->types.push_back( type );
+    this->wordTypes.push_back( -1 );
+}
+
+int TokenStore::offset( const int token ) const
+{
+    return this->offsets.at( token );
+}
+
+int TokenStore::length( const int token ) const
+{
+    return this->lengths.at( token );
+}
+
+TYPE TokenStore::type( const int token ) const
+{
+    return this->types.at( token );
+}
+
+bool TokenStore::isWordType( const int token ) const
+{
+    return ( this->types.at( token ) == TYPE::WORD );
+}
+
+QStringRef TokenStore::content( const int token ) const
+{
+    return QStringRef{ &this->text, this->offsets.at( token ), this->lengths.at( token ) };
+}
+
+int TokenStore::wordType( const int token ) const
+{
+    return this->wordTypes.at( token );
+}
+
+void TokenStore::setWordType( const int token, const int wordType )
+{
+    this->wordTypes[token] = wordType;
+}
+
+bool TokenStore::hasTranslations( const int token ) const
+{
+    const int wordType = this->wordTypes.at( token );
+
+    return wordType >= 0 && !this->translationLists.at( wordType ).isEmpty();
+}
+
+QVector<int> TokenStore::getTranslationIds( const int token ) const
+{
+    const int wordType = this->wordTypes.at( token );
+
+    return ( wordType >= 0 ) ? this->translationLists.at( wordType ) : QVector<int>{};
+}
+
+QVector<QString> TokenStore::getTranslations( const int token ) const
+{
+    return this->interner->strings( this->getTranslationIds( token ) );
+}
+
+void TokenStore::clearWordTypes()
+{
+    this->wordTypes.fill( -1 );
+    this->wordTypeContentIds.clear();
+    this->translationLists.clear();
+
+    // copies still using the strings of the old word types keep the old interner
+    this->interner.reset( new StringInterner );
+}
+
+int TokenStore::addWordType( const QString &word )
+{
+    this->wordTypeContentIds.push_back( this->interner->intern( word ) );
+    this->translationLists.push_back( QVector<int>{} );
+
+    return this->wordTypeContentIds.size() - 1;
+}
+
+int TokenStore::wordTypeCount() const
+{
+    return this->wordTypeContentIds.size();
+}
+
+QString TokenStore::wordTypeContent( const int wordType ) const
+{
+    return this->interner->string( this->wordTypeContentIds.at( wordType ) );
+}
+
+QVector<int> TokenStore::wordTypeTranslationIds( const int wordType ) const
+{
+    return this->translationLists.at( wordType );
+}
+
+void TokenStore::setTranslations( const int wordType, const QVector<QString> &translations )
+{
+    this->translationLists[wordType] = this->interner->intern( translations );
+}
+
+QString TokenStore::string( const int id ) const
+{
+    return this->interner->string( id );
+}
+
+qint64 TokenStore::memoryUsage() const
+{
+    qint64 bytes = vectorCost( this->offsets ) + vectorCost( this->lengths ) +
+                   vectorCost( this->types ) + vectorCost( this->wordTypes ) +
+                   vectorCost( this->wordTypeContentIds ) + vectorCost( this->translationLists );
+
+    for( const QVector<int> &translationIds : this->translationLists )
+    {
+        bytes += vectorCost( translationIds );
+    }
+
+    return bytes;
+}
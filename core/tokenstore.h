@@ -0,0 +1,84 @@
+#ifndef TOKENSTORE_H
+#define TOKENSTORE_H
+
+#include <QSharedPointer>
+#include <QString>
+#include <QStringRef>
+#include <QVector>
+
+class StringInterner;
+
+enum class TYPE : quint8
+{
+    WORD,
+    LINK,
+    UNKOWN
+};
+
+// Words and links of an analysed text, stored as one array per field instead of
+// one object per token, so walking all tokens streams through a few flat arrays.
+//
+// A token is a slice of the text, which is shared with the caller and never copied.
+// Every distinct word is a word type holding its content and translations as ids
+// of a StringInterner, all tokens of a word share them. The interner belongs to the
+// word types: copies of the store share it, clearWordTypes() starts a new one and the
+// old one is freed with the last store using it.
+class TokenStore
+{
+public:
+    TokenStore();
+    explicit TokenStore( const QString &text );
+
+    const QString &getText() const;
+
+    int size() const;
+    bool isEmpty() const;
+    void reserve( const int count );
+
+    void append( const int offset, const int length, const TYPE type );
+
+    int offset( const int token ) const;
+    int length( const int token ) const;
+    TYPE type( const int token ) const;
+    bool isWordType( const int token ) const;
+    QStringRef content( const int token ) const;
+
+    // word type of a word, -1 for links and words no type was assigned to yet
+    int wordType( const int token ) const;
+    void setWordType( const int token, const int wordType );
+
+    bool hasTranslations( const int token ) const;
+    QVector<int> getTranslationIds( const int token ) const;
+    QVector<QString> getTranslations( const int token ) const;
+
+    // drops all word types and their strings, every token becomes untyped
+    void clearWordTypes();
+    int addWordType( const QString &word );
+    int wordTypeCount() const;
+    QString wordTypeContent( const int wordType ) const;
+    QVector<int> wordTypeTranslationIds( const int wordType ) const;
+    // changes the translations of all tokens of wordType at once
+    void setTranslations( const int wordType, const QVector<QString> &translations );
+
+    // string of an id returned by getTranslationIds() or wordTypeTranslationIds()
+    QString string( const int id ) const;
+
+    // estimated heap memory of the arrays, not counting the text and the interned strings
+    qint64 memoryUsage() const;
+
+private:
+    QString text;
+    QSharedPointer<StringInterner> interner;
+
+    // indexed by token
+    QVector<int> offsets;
+    QVector<int> lengths;
+    QVector<TYPE> types;
+    QVector<int> wordTypes;
+
+    // indexed by word type
+    QVector<int> wordTypeContentIds;
+    QVector<QVector<int>> translationLists;
+};
+
+#endif // TOKENSTORE_H
@@ -0,0 +1,359 @@
+#include "translationcache.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+
+namespace
+{
+    // QArrayData header plus the allocation granularity of a string or vector
+    const qint64 allocationOverhead{ 32 };
+
+    // a QHash node holding the key and the entry id
+    const qint64 hashNodeOverhead{ 32 };
+
+    qint64 stringCost( const QString &str )
+    {
+        return static_cast<qint64>( sizeof( QString ) ) + allocationOverhead + str.size() * 2;
+    }
+}
+
+// definitions of the constants, they are odr-used e.g. when bound to a reference
+const qint64 TranslationCache::defaultMemoryBudget;
+const quint32 TranslationCache::magic;
+const quint32 TranslationCache::version;
+
+TranslationCache::TranslationCache( const qint64 memoryBudget )
+: head{ -1 }
+, tail{ -1 }
+, memoryBudget{ memoryBudget }
+, memoryUsage{ 0 }
+, hits{ 0 }
+, misses{ 0 }
+{
+}
+
+bool TranslationCache::find( const QString &foreignWord, QVector<QString> &translations )
+{
+    auto entryId = this->entryIds.constFind( foreignWord );
+
+    if( entryId == this->entryIds.constEnd() )
+    {
+        ++this->misses;
+        return false;
+    }
+
+    ++this->hits;
+
+    if( entryId.value() != this->head )
+    {
+        this->unlink( entryId.value() );
+        this->pushFront( entryId.value() );
+    }
+
+    translations = this->entries.at( entryId.value() ).translations;
+
+    return true;
+}
+
+bool TranslationCache::contains( const QString &foreignWord ) const
+{
+    return this->entryIds.contains( foreignWord );
+}
+
+void TranslationCache::insert( const QString &foreignWord, const QVector<QString> &translations )
+{
+    auto existing = this->entryIds.constFind( foreignWord );
+
+    if( existing != this->entryIds.constEnd() )
+    {
+        this->setTranslations( existing.value(), translations );
+        this->unlink( existing.value() );
+        this->pushFront( existing.value() );
+        this->evict();
+        return;
+    }
+
+    int entryId;
+
+    if( this->freeEntries.isEmpty() )
+    {
+        entryId = this->entries.size();
+        this->entries.push_back( Entry{ foreignWord, translations, 0, -1, -1 } );
+    }
+    else
+    {
+        entryId = this->freeEntries.takeLast();
+        this->entries[entryId].foreignWord = foreignWord;
+        this->entries[entryId].translations = translations;
+    }
+
+    Entry &entry = this->entries[entryId];
+    entry.cost = TranslationCache::cost( foreignWord, translations );
+    this->memoryUsage += entry.cost;
+
+    this->entryIds.insert( foreignWord, entryId );
+    this->pushFront( entryId );
+    this->evict();
+}
+
+void TranslationCache::remove( const QString &foreignWord )
+{
+    auto entryId = this->entryIds.constFind( foreignWord );
+
+    if( entryId != this->entryIds.constEnd() )
+    {
+        this->removeEntry( entryId.value() );
+    }
+}
+
+void TranslationCache::clear()
+{
+    this->entryIds.clear();
+    this->entries.clear();
+    this->freeEntries.clear();
+    this->head = -1;
+    this->tail = -1;
+    this->memoryUsage = 0;
+}
+
+void TranslationCache::addTranslation( const QString &foreignWord, const QString &translation )
+{
+    auto entryId = this->entryIds.constFind( foreignWord );
+
+    if( entryId == this->entryIds.constEnd() ||
+        this->entries.at( entryId.value() ).translations.contains( translation ) )
+    {
+        return;
+    }
+
+    QVector<QString> translations{ this->entries.at( entryId.value() ).translations };
+    translations.push_back( translation );
+
+    this->setTranslations( entryId.value(), translations );
+    this->evict();
+}
+
+void TranslationCache::removeTranslation( const QString &foreignWord, const QString &translation )
+{
+    auto entryId = this->entryIds.constFind( foreignWord );
+
+    if( entryId == this->entryIds.constEnd() )
+    {
+        return;
+    }
+
+    QVector<QString> translations{ this->entries.at( entryId.value() ).translations };
+    translations.removeAll( translation );
+
+    this->setTranslations( entryId.value(), translations );
+}
+
+void TranslationCache::setMemoryBudget( const qint64 memoryBudget )
+{
+    this->memoryBudget = memoryBudget;
+    this->evict();
+}
+
+qint64 TranslationCache::getMemoryBudget() const
+{
+    return this->memoryBudget;
+}
+
+qint64 TranslationCache::getMemoryUsage() const
+{
+    return this->memoryUsage;
+}
+
+int TranslationCache::size() const
+{
+    return this->entryIds.size();
+}
+
+quint64 TranslationCache::getHits() const
+{
+    return this->hits;
+}
+
+quint64 TranslationCache::getMisses() const
+{
+    return this->misses;
+}
+
+double TranslationCache::getHitRate() const
+{
+    const quint64 lookups = this->hits + this->misses;
+
+    return ( lookups > 0 ) ? static_cast<double>( this->hits ) / lookups : 0.0;
+}
+
+void TranslationCache::resetStatistics()
+{
+    this->hits = 0;
+    this->misses = 0;
+}
+
+bool TranslationCache::save( const QString &fileName, const qint64 generation ) const
+{
+    QSaveFile file{ fileName };
+
+    if( !file.open( QFile::WriteOnly ) )
+    {
+        return false;
+    }
+
+    QDataStream stream{ &file };
+    stream.setVersion( QDataStream::Qt_5_0 );
+
+    stream << TranslationCache::magic << TranslationCache::version << generation
+           << static_cast<qint32>( this->size() );
+
+    // loading inserts in the same order, the most recently used words are kept by the budget
+    for( int entryId = this->tail; entryId >= 0; entryId = this->entries.at( entryId ).previous )
+    {
+        stream << this->entries.at( entryId ).foreignWord << this->entries.at( entryId ).translations;
+    }
+
+    return stream.status() == QDataStream::Ok && file.commit();
+}
+
+bool TranslationCache::load( const QString &fileName, const qint64 generation )
+{
+    QFile file{ fileName };
+
+    if( !file.open( QFile::ReadOnly ) )
+    {
+        return false;
+    }
+
+    QDataStream stream{ &file };
+    stream.setVersion( QDataStream::Qt_5_0 );
+
+    quint32 fileMagic{ 0 };
+    quint32 fileVersion{ 0 };
+    qint64 fileGeneration{ -1 };
+    qint32 count{ 0 };
+
+    stream >> fileMagic >> fileVersion >> fileGeneration >> count;
+
+    if( stream.status() != QDataStream::Ok || fileMagic != TranslationCache::magic ||
+        fileVersion != TranslationCache::version || fileGeneration != generation )
+    {
+        return false;
+    }
+
+    for( qint32 i = 0; i < count; ++i )
+    {
+        QString foreignWord;
+        QVector<QString> translations;
+
+        stream >> foreignWord >> translations;
+
+        if( stream.status() != QDataStream::Ok )
+        {
+            return false;
+        }
+
+        this->insert( foreignWord, translations );
+    }
+
+    return true;
+}
+
+// an estimate of the heap memory of an entry, the translations are usually
+// shared with the dictionary index and the words of the text
+qint64 TranslationCache::cost( const QString &foreignWord, const QVector<QString> &translations )
+{
+    qint64 bytes = static_cast<qint64>( sizeof( Entry ) ) + hashNodeOverhead + stringCost( foreignWord );
+
+    if( !translations.isEmpty() )
+    {
+        bytes += allocationOverhead;
+    }
+
+    for( const QString &translation : translations )
+    {
+        bytes += stringCost( translation );
+    }
+
+    return bytes;
+}
+
+void TranslationCache::unlink( const int entryId )
+{
+    Entry &entry = this->entries[entryId];
+
+    if( entry.previous >= 0 )
+    {
+        this->entries[entry.previous].next = entry.next;
+    }
+    else
+    {
+        this->head = entry.next;
+    }
+
+    if( entry.next >= 0 )
+    {
+        this->entries[entry.next].previous = entry.previous;
+    }
+    else
+    {
+        this->tail = entry.previous;
+    }
+
+    entry.previous = -1;
+    entry.next = -1;
+}
+
+void TranslationCache::pushFront( const int entryId )
+{
+    Entry &entry = this->entries[entryId];
+    entry.previous = -1;
+    entry.next = this->head;
+
+    if( this->head >= 0 )
+    {
+        this->entries[this->head].previous = entryId;
+    }
+
+    this->head = entryId;
+
+    if( this->tail < 0 )
+    {
+        this->tail = entryId;
+    }
+}
+
+void TranslationCache::setTranslations( const int entryId, const QVector<QString> &translations )
+{
+    Entry &entry = this->entries[entryId];
+
+    this->memoryUsage -= entry.cost;
+    entry.translations = translations;
+    entry.cost = TranslationCache::cost( entry.foreignWord, translations );
+    this->memoryUsage += entry.cost;
+}
+
+void TranslationCache::removeEntry( const int entryId )
+{
+    Entry &entry = this->entries[entryId];
+
+    this->unlink( entryId );
+    this->entryIds.remove( entry.foreignWord );
+    this->memoryUsage -= entry.cost;
+
+    entry.foreignWord.clear();
+    entry.translations.clear();
+    entry.cost = 0;
+
+    this->freeEntries.push_back( entryId );
+}
+
+// the most recently used entry is always kept, even if it alone exceeds the budget
+void TranslationCache::evict()
+{
+    while( this->memoryUsage > this->memoryBudget && this->tail >= 0 && this->tail != this->head )
+    {
+        this->removeEntry( this->tail );
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef TRANSLATIONCACHE_H
+#define TRANSLATIONCACHE_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+// Translations looked up so far, foreign word -> native words.
+//
+// Bounded by an estimated memory budget: once it is exceeded, the least recently
+// used words are evicted. Entries are kept in a vector and linked by index into
+// the LRU list, so a lookup is one hash lookup plus relinking two neighbours.
+// Hits and misses are counted to tune the budget for long sessions.
+//
+// The cache of a language pair can be saved and loaded again in the next session,
+// tagged with the dictionary generation it was resolved at (see DB_Manager).
+class TranslationCache
+{
+public:
+    static const qint64 defaultMemoryBudget{ 16 * 1024 * 1024 };
+    static const quint32 magic{ 0x4354434D };   // "MCTC"
+    static const quint32 version{ 1 };
+
+    explicit TranslationCache( const qint64 memoryBudget = defaultMemoryBudget );
+
+    // counts a hit or a miss, a hit becomes the most recently used word
+    bool find( const QString &foreignWord, QVector<QString> &translations );
+
+    // neither counts nor changes the order
+    bool contains( const QString &foreignWord ) const;
+
+    void insert( const QString &foreignWord, const QVector<QString> &translations );
+    void remove( const QString &foreignWord );
+    void clear();
+
+    // change the translations of foreignWord only if it is cached
+    void addTranslation( const QString &foreignWord, const QString &translation );
+    void removeTranslation( const QString &foreignWord, const QString &translation );
+
+    // evicts immediately if the new budget is exceeded
+    void setMemoryBudget( const qint64 memoryBudget );
+    qint64 getMemoryBudget() const;
+    qint64 getMemoryUsage() const;
+    int size() const;
+
+    quint64 getHits() const;
+    quint64 getMisses() const;
+    // 0.0 .. 1.0, 0.0 before the first lookup
+    double getHitRate() const;
+    void resetStatistics();
+
+    // writes all words, least recently used first, replacing fileName atomically
+    bool save( const QString &fileName, const qint64 generation ) const;
+
+    // inserts the words of fileName if it was saved at generation, returns false otherwise
+    bool load( const QString &fileName, const qint64 generation );
+
+private:
+    struct Entry
+    {
+        QString foreignWord;
+        QVector<QString> translations;
+        qint64 cost;
+        // neighbours in the LRU list, -1 at its ends
+        int previous;
+        int next;
+    };
+
+    static qint64 cost( const QString &foreignWord, const QVector<QString> &translations );
+
+    void unlink( const int entryId );
+    void pushFront( const int entryId );
+    void setTranslations( const int entryId, const QVector<QString> &translations );
+    void removeEntry( const int entryId );
+    void evict();
+
+    QHash<QString, int> entryIds;
+    QVector<Entry> entries;
+    // unused slots of entries
+    QVector<int> freeEntries;
+
+    // most and least recently used entry, -1 if empty
+    int head;
+    int tail;
+
+    qint64 memoryBudget;
+    qint64 memoryUsage;
+
+    quint64 hits;
+    quint64 misses;
+};
+
+#endif // TRANSLATIONCACHE_H
@@ -0,0 +1,22 @@
+#-------------------------------------------------
+#
+# Generator of synthetic dictionaries and texts for load tests, e.g.
+#   generator --languages 4 --words 250000 --fan-out 2 --texts texts load.db
+#
+#-------------------------------------------------
+
+QT       += core sql
+
+TARGET = generator
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+CONFIG += c++11
+
+include(../core/core.pri)
+
+SOURCES += \
+    main.cpp
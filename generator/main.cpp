@@ -0,0 +1,133 @@
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+
+#include <algorithm>
+
+#include "db_manager.h"
+#include "syntheticdata.h"
+
+// Fills a copy of mycutethesaurus.db with synthetic languages, words and
+// translations and writes matching, Zipf distributed texts, to reproduce
+// production scale load locally.
+int main( int argc, char *argv[] )
+{
+    QCoreApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Generates a synthetic dictionary and texts for load testing." );
+    parser.addHelpOption();
+
+    const QCommandLineOption templateOption{ "template", "Database to copy the schema from.", "file",
+                                             "mycutethesaurus.db" };
+    const QCommandLineOption languagesOption{ "languages", "Count of languages.", "n", "2" };
+    const QCommandLineOption wordsOption{ "words", "Words per language.", "m", "10000" };
+    const QCommandLineOption fanOutOption{ "fan-out", "Translations per word into every other language.", "f", "1" };
+    const QCommandLineOption textsOption{ "texts", "Directory to write texts to, none are written if not set.", "dir" };
+    const QCommandLineOption textCountOption{ "text-count", "Count of texts.", "k", "1" };
+    const QCommandLineOption textWordsOption{ "text-words", "Words per text.", "w", "10000" };
+    const QCommandLineOption zipfOption{ "zipf", "Exponent of the Zipf distribution of the texts.", "s", "1.0" };
+    const QCommandLineOption seedOption{ "seed", "Seed of the first text, every further one adds 1.", "seed", "42" };
+
+    parser.addOptions( { templateOption, languagesOption, wordsOption, fanOutOption,
+                         textsOption, textCountOption, textWordsOption, zipfOption, seedOption } );
+    parser.addPositionalArgument( "database", "Database to create, overwritten if it exists." );
+
+    parser.process( app );
+
+    QTextStream out{ stdout };
+    QTextStream errorStream{ stderr };
+
+    if( parser.positionalArguments().size() != 1 )
+    {
+        parser.showHelp( 1 );
+    }
+
+    const QString dbName{ parser.positionalArguments().first() };
+
+    const SyntheticData::DictionaryOptions options{ parser.value( languagesOption ).toInt(),
+                                                    parser.value( wordsOption ).toInt(),
+                                                    parser.value( fanOutOption ).toInt() };
+
+    if( options.languageCount < 1 || options.wordsPerLanguage < 1 || options.fanOut < 0 )
+    {
+        errorStream << "Invalid count of languages, words or translations." << endl;
+        return 1;
+    }
+
+    SyntheticData::DictionaryStatistics statistics;
+
+    if( !SyntheticData::createDictionary( parser.value( templateOption ), dbName, options, &statistics ) )
+    {
+        errorStream << "Could not create " << dbName << endl;
+        return 1;
+    }
+
+    const qint64 rows = statistics.words + statistics.translations;
+
+    out << "Languages:    " << statistics.languages.join( ", " ) << endl
+        << "Words:        " << statistics.words << endl
+        << "Translations: " << statistics.translations << endl
+        << "Inserted in " << statistics.milliseconds << " ms ("
+        << ( rows * 1000 / std::max<qint64>( 1, statistics.milliseconds ) ) << " rows/s)" << endl;
+
+    // DB_Manager brings the new database to the current schema version, adding the indexes
+    QElapsedTimer timer;
+    timer.start();
+
+    try
+    {
+        DB_Manager dbManager{ nullptr, dbName, "generator" };
+    }
+    catch( const QString &error )
+    {
+        errorStream << error << endl;
+        return 1;
+    }
+    catch( const char *error )
+    {
+        errorStream << error << endl;
+        return 1;
+    }
+
+    out << "Migrated in " << timer.elapsed() << " ms" << endl;
+
+    if( !parser.isSet( textsOption ) )
+    {
+        return 0;
+    }
+
+    const QDir textDir{ parser.value( textsOption ) };
+
+    if( !textDir.mkpath( "." ) )
+    {
+        errorStream << "Could not create " << textDir.path() << endl;
+        return 1;
+    }
+
+    const int textCount = parser.value( textCountOption ).toInt();
+    const int textWords = parser.value( textWordsOption ).toInt();
+    const double zipfExponent = parser.value( zipfOption ).toDouble();
+    const uint seed = parser.value( seedOption ).toUInt();
+
+    for( int i = 0; i < textCount; ++i )
+    {
+        QFile file{ textDir.filePath( QString{ "text_%1.txt" }.arg( i + 1 ) ) };
+
+        if( !file.open( QFile::WriteOnly | QFile::Truncate ) )
+        {
+            errorStream << "Could not write " << file.fileName() << ": " << file.errorString() << endl;
+            return 1;
+        }
+
+        file.write( SyntheticData::corpus( textWords, options.wordsPerLanguage, zipfExponent, seed + i ).toUtf8() );
+
+        out << "Written " << file.fileName() << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,29 @@
+#-------------------------------------------------
+#
+# Counts the heap allocations of analysing texts of different lengths.
+# Replaces malloc(), so it is an executable of its own, counting only works with glibc.
+# Run with "make check" or "-platform offscreen" on machines without a display
+#
+#-------------------------------------------------
+
+QT       += core gui sql concurrent testlib
+
+TARGET = allocationtests
+TEMPLATE = app
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+# databases are created from copies of the shipped, empty database
+DEFINES += THESAURUS_TEMPLATE_DB=\\\"$$PWD/../../mycutethesaurus.db\\\"
+
+CONFIG += c++11
+
+include(../../core/core.pri)
+
+# helpers shared with the tests
+INCLUDEPATH += $$PWD/..
+
+SOURCES += \
+    allocationtest.cpp
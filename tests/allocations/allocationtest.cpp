@@ -0,0 +1,165 @@
+#include <QGuiApplication>
+#include <QFont>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include <atomic>
+
+#include "db_manager.h"
+#include "dictionaryindex.h"
+#include "syntheticdata.h"
+#include "testfixtures.h"
+#include "textanalyser.h"
+#include "textrenderer.h"
+#include "tokenstore.h"
+#include "translationcache.h"
+
+#if defined( __GLIBC__ )
+// every heap allocation of the process is counted while allocationCounting is set,
+// Qt's containers allocate with malloc() directly, so operator new alone isn't enough
+namespace
+{
+    std::atomic<bool> allocationCounting{ false };
+    std::atomic<quint64> allocations{ 0 };
+
+    inline void countAllocation()
+    {
+        if( allocationCounting.load( std::memory_order_relaxed ) )
+        {
+            allocations.fetch_add( 1, std::memory_order_relaxed );
+        }
+    }
+}
+
+extern "C"
+{
+    void *__libc_malloc( size_t size );
+    void *__libc_calloc( size_t count, size_t size );
+    void *__libc_realloc( void *pointer, size_t size );
+
+    void *malloc( size_t size )
+    {
+        countAllocation();
+        return __libc_malloc( size );
+    }
+
+    void *calloc( size_t count, size_t size )
+    {
+        countAllocation();
+        return __libc_calloc( count, size );
+    }
+
+    void *realloc( void *pointer, size_t size )
+    {
+        countAllocation();
+        return __libc_realloc( pointer, size );
+    }
+}
+#endif
+
+namespace
+{
+    // words the texts are drawn from, half of them are in the dictionary
+    const int vocabularySize{ 1000 };
+    const int dictionarySize{ 500 };
+
+    // language ids of the dictionary, taken from the shipped database
+    const int foreignLangId{ 2 };
+    const int nativeLangId{ 1 };
+
+    // a word type costs its copy, the hash nodes of the analysis, the interner and
+    // the cache, its looked up translations and its occurrence list, about ten
+    const quint64 allocationsPerWordType{ 16 };
+
+    // arrays growing with the text double their capacity, a few dozen times at most
+    // for any text size, plus the few containers every analysis creates
+    const quint64 allocationsPerText{ 512 };
+}
+
+// Tokenising, resolving and laying out a text may only allocate per word type,
+// never per token: the allocations are bounded by the count of distinct words,
+// whatever the length of the text is.
+class AllocationTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void analyse_data();
+    void analyse();
+
+private:
+    QTemporaryDir tempDir;
+    DictionaryIndex dictionaryIndex;
+};
+
+void AllocationTest::initTestCase()
+{
+#if !defined( __GLIBC__ )
+    QSKIP( "Allocations are only counted with glibc" );
+#endif
+
+    QVERIFY( this->tempDir.isValid() );
+
+    const QString dbName{ this->tempDir.filePath( "dictionary.db" ) };
+
+    // en <-> de, one translation per word
+    const SyntheticData::DictionaryOptions options{ 2, dictionarySize, 1 };
+    QVERIFY( SyntheticData::createDictionary( THESAURUS_TEMPLATE_DB, dbName, options ) );
+
+    DB_Manager dbManager{ nullptr, dbName, "allocations" };
+    this->dictionaryIndex.build( dbManager.getAllTranslations( foreignLangId, nativeLangId ) );
+}
+
+void AllocationTest::analyse_data()
+{
+    QTest::addColumn<int>( "wordCount" );
+
+    QTest::newRow( "10k words" ) << 10000;
+    QTest::newRow( "100k words" ) << 100000;
+    QTest::newRow( "1M words" ) << 1000000;
+}
+
+void AllocationTest::analyse()
+{
+#if defined( __GLIBC__ )
+    QFETCH( int, wordCount );
+
+    const QString text{ SyntheticData::corpus( wordCount, vocabularySize ) };
+
+    const TextAnalyser analyser{ TextAnalyser::defaultWordSeperators() };
+    TokenStore foreign_words;
+    TranslationCache cachedTranslations;
+    TextRenderer renderer{ QFont{ "Courier" }, TestFixtures::textColors() };
+
+    allocations = 0;
+    allocationCounting = true;
+
+    analyser.tokenise( text, foreign_words );
+    analyser.buildTranslationStructure( foreign_words, this->dictionaryIndex, cachedTranslations );
+    renderer.buildLayout( foreign_words );
+
+    allocationCounting = false;
+
+    const quint64 wordTypes = static_cast<quint64>( foreign_words.wordTypeCount() );
+    const quint64 bound = allocationsPerWordType * wordTypes + allocationsPerText;
+
+    qInfo( "%d tokens, %llu word types: %llu allocations, bound %llu",
+           foreign_words.size(), wordTypes, allocations.load(), bound );
+
+    QVERIFY( allocations.load() <= bound );
+#endif
+}
+
+int main( int argc, char *argv[] )
+{
+    // TextRenderer needs fonts
+    QGuiApplication app( argc, argv );
+
+    AllocationTest test;
+
+    return QTest::qExec( &test, argc, argv );
+}
+
+#include "allocationtest.moc"
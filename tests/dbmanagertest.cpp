@@ -0,0 +1,86 @@
+#include "dbmanagertest.h"
+
+#include <QFile>
+#include <QtTest>
+
+namespace
+{
+    // language ids of the shipped database
+    const int foreignLangId{ 2 };
+    const int nativeLangId{ 1 };
+}
+
+void DbManagerTest::init()
+{
+    QVERIFY( this->tempDir.isValid() );
+
+    const QString dbName{ this->tempDir.filePath( "thesaurus.db" ) };
+
+    QFile::remove( dbName );
+    QVERIFY( QFile::copy( THESAURUS_TEMPLATE_DB, dbName ) );
+    QFile::setPermissions( dbName, QFile::ReadOwner | QFile::WriteOwner );
+
+    this->dbManager.reset( new DB_Manager{ nullptr, dbName, "dbmanagertest" } );
+    QVERIFY( this->dbManager->isOk() );
+}
+
+void DbManagerTest::cleanup()
+{
+    this->dbManager.reset();
+}
+
+void DbManagerTest::translate( const QString &foreignWord, const QString &nativeWord ) const
+{
+    this->dbManager->translate( nativeWord, nativeLangId, foreignWord, foreignLangId );
+    this->dbManager->translate( foreignWord, foreignLangId, nativeWord, nativeLangId );
+}
+
+void DbManagerTest::renameWord()
+{
+    this->translate( "house", "Haus" );
+
+    const int wordId = this->dbManager->getWordId( "Haus", nativeLangId );
+
+    QCOMPARE( this->dbManager->update( wordId, "Heim" ), wordId );
+    QCOMPARE( this->dbManager->getTanslations( "house", foreignLangId, nativeLangId ),
+              QVector<QString>{ "Heim" } );
+    QVERIFY( !this->dbManager->isKnownWord( "Haus", nativeLangId ) );
+}
+
+void DbManagerTest::renameOntoKnownWord()
+{
+    this->translate( "house", "Haus" );
+    this->translate( "home", "Heim" );
+
+    const int wordId = this->dbManager->getWordId( "Haus", nativeLangId );
+    const int knownWordId = this->dbManager->getWordId( "Heim", nativeLangId );
+    const qint64 generation{ this->dbManager->getDictionaryGeneration() };
+
+    // the translations of "Haus" are moved to "Heim"
+    QCOMPARE( this->dbManager->update( wordId, "Heim" ), knownWordId );
+
+    QCOMPARE( this->dbManager->getTanslations( "house", foreignLangId, nativeLangId ),
+              QVector<QString>{ "Heim" } );
+    QCOMPARE( this->dbManager->getTanslations( "home", foreignLangId, nativeLangId ),
+              QVector<QString>{ "Heim" } );
+    QCOMPARE( this->dbManager->getTanslations( "Heim", nativeLangId, foreignLangId ).size(), 2 );
+    QVERIFY( !this->dbManager->isKnownWord( "Haus", nativeLangId ) );
+    QVERIFY( this->dbManager->getDictionaryGeneration() > generation );
+}
+
+void DbManagerTest::renameOntoKnownTranslation()
+{
+    this->translate( "house", "Haus" );
+    this->translate( "house", "Heim" );
+
+    const int wordId = this->dbManager->getWordId( "Haus", nativeLangId );
+
+    // "house" already translates to "Heim", the translation is kept once
+    QCOMPARE( this->dbManager->update( wordId, "Heim" ),
+              this->dbManager->getWordId( "Heim", nativeLangId ) );
+
+    QCOMPARE( this->dbManager->getTanslations( "house", foreignLangId, nativeLangId ),
+              QVector<QString>{ "Heim" } );
+    QCOMPARE( this->dbManager->getTanslations( "Heim", nativeLangId, foreignLangId ),
+              QVector<QString>{ "house" } );
+}
@@ -0,0 +1,31 @@
+#ifndef DBMANAGERTEST_H
+#define DBMANAGERTEST_H
+
+#include <QObject>
+#include <QScopedPointer>
+#include <QTemporaryDir>
+
+#include "db_manager.h"
+
+// Writing calls of DB_Manager, every test function gets a fresh copy of the shipped database
+class DbManagerTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void renameWord();
+    void renameOntoKnownWord();
+    void renameOntoKnownTranslation();
+
+private:
+    // in both directions, like TranslationDialog does
+    void translate( const QString &foreignWord, const QString &nativeWord ) const;
+
+    QTemporaryDir tempDir;
+    QScopedPointer<DB_Manager> dbManager;
+};
+
+#endif // DBMANAGERTEST_H
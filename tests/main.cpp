@@ -0,0 +1,30 @@
+#include <QGuiApplication>
+#include <QtTest>
+
+#include "dbmanagertest.h"
+#include "tokenizertest.h"
+
+namespace
+{
+    template<typename Test>
+    int run( int argc, char *argv[] )
+    {
+        Test test;
+
+        return QTest::qExec( &test, argc, argv );
+    }
+}
+
+// runs every test class, the exit code is the count of failed tests
+int main( int argc, char *argv[] )
+{
+    // TextRenderer needs fonts
+    QGuiApplication app( argc, argv );
+
+    int failed = 0;
+
+    failed += run<DbManagerTest>( argc, argv );
+    failed += run<TokenizerTest>( argc, argv );
+
+    return failed;
+}
@@ -0,0 +1,65 @@
+#ifndef TESTFIXTURES_H
+#define TESTFIXTURES_H
+
+#include <QMap>
+#include <QMetaType>
+#include <QString>
+#include <QVector>
+
+#include "textrenderer.h"
+#include "tokenizer.h"
+
+// rows of data driven tests are run with every instruction set
+Q_DECLARE_METATYPE( Tokenizer::InstructionSet )
+
+// Helpers shared by the tests, the allocation tests and the benchmarks
+namespace TestFixtures
+{
+    inline QString instructionSetName( const Tokenizer::InstructionSet instructionSet )
+    {
+        switch( instructionSet )
+        {
+        case Tokenizer::InstructionSet::SCALAR:
+            return "scalar";
+        case Tokenizer::InstructionSet::SSE2:
+            return "sse2";
+        case Tokenizer::InstructionSet::AVX2:
+            return "avx2";
+        }
+
+        return QString{};
+    }
+
+    // instruction sets are ordered, a machine supports every one up to the detected one
+    inline QVector<Tokenizer::InstructionSet> supportedInstructionSets()
+    {
+        QVector<Tokenizer::InstructionSet> instructionSets{ Tokenizer::InstructionSet::SCALAR };
+
+        if( Tokenizer::detectInstructionSet() >= Tokenizer::InstructionSet::SSE2 )
+        {
+            instructionSets.push_back( Tokenizer::InstructionSet::SSE2 );
+        }
+
+        if( Tokenizer::detectInstructionSet() >= Tokenizer::InstructionSet::AVX2 )
+        {
+            instructionSets.push_back( Tokenizer::InstructionSet::AVX2 );
+        }
+
+        return instructionSets;
+    }
+
+    // the default colors of MainWindow
+    inline QMap<TextTypeColor, QString> textColors()
+    {
+        return QMap<TextTypeColor, QString>{ { TextTypeColor::FOREIGN_TEXT_KNOWN_COLOR, "#32ab32" },
+                                             { TextTypeColor::FOREIGN_TEXT_UNKNOWN_COLOR, "#ff0000" },
+                                             { TextTypeColor::NATIVE_UNMARKED_TEXT_COLOR, "#010101" },
+                                             { TextTypeColor::NATIVE_MARKED_TEXT_COLOR, "#A0A0A0" },
+                                             { TextTypeColor::STATISTIC_KNOWN_WORDS_COLOR, "#32ab32" },
+                                             { TextTypeColor::STATISTIC_UNKNOWN_WORDS_COLOR, "#ff0000" },
+                                             { TextTypeColor::HORIZONTAL_LINE_COLOR, "#bcbcbc" },
+                                             { TextTypeColor::SEPERATOR_COLOR, "#999999" } };
+    }
+}
+
+#endif // TESTFIXTURES_H
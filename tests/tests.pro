@@ -0,0 +1,32 @@
+#-------------------------------------------------
+#
+# Unit tests of the analysis core, every test class is run by main.cpp.
+# Run with "make check" or "-platform offscreen" on machines without a display
+#
+#-------------------------------------------------
+
+QT       += core gui sql concurrent testlib
+
+TARGET = tests
+TEMPLATE = app
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+# databases are created from copies of the shipped, empty database
+DEFINES += THESAURUS_TEMPLATE_DB=\\\"$$PWD/../mycutethesaurus.db\\\"
+
+CONFIG += c++11
+
+include(../core/core.pri)
+
+SOURCES += \
+    main.cpp \
+    dbmanagertest.cpp \
+    tokenizertest.cpp
+
+HEADERS += \
+    dbmanagertest.h \
+    testfixtures.h \
+    tokenizertest.h
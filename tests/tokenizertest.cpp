@@ -0,0 +1,131 @@
+#include "tokenizertest.h"
+
+#include <QStringList>
+#include <QtTest>
+
+#include "testfixtures.h"
+#include "textanalyser.h"
+#include "tokenizer.h"
+#include "tokenstore.h"
+
+namespace
+{
+    // "W:" for words and "L:" for links, followed by the content
+    QStringList describe( const TokenStore &tokens )
+    {
+        QStringList description;
+
+        for( int i = 0; i < tokens.size(); ++i )
+        {
+            description << ( tokens.isWordType( i ) ? "W:" : "L:" ) + tokens.content( i ).toString();
+        }
+
+        return description;
+    }
+}
+
+void TokenizerTest::tokenise_data()
+{
+    QTest::addColumn<Tokenizer::InstructionSet>( "instructionSet" );
+    QTest::addColumn<QString>( "text" );
+    QTest::addColumn<QStringList>( "expected" );
+
+    // a letter outside the BMP (U+1D49C, mathematical script capital A) and one which is no letter (U+1F600)
+    const QString scriptA{ QString::fromUcs4( U"\U0001D49C" ) };
+    const QString emoji{ QString::fromUcs4( U"\U0001F600" ) };
+
+    for( const Tokenizer::InstructionSet instructionSet : TestFixtures::supportedInstructionSets() )
+    {
+        auto newRow = [instructionSet]( const QString &name ) -> QTestData &
+        {
+            return QTest::newRow( qPrintable( TestFixtures::instructionSetName( instructionSet ) + ": " + name ) )
+                    << instructionSet;
+        };
+
+        newRow( "empty" ) << QString{} << QStringList{};
+        newRow( "plain words" ) << "hello world" << QStringList{ "W:hello", "L: ", "W:world" };
+        newRow( "links" ) << "a, b. c!\n" << QStringList{ "W:a", "L:, ", "W:b", "L:. ", "W:c", "L:!\n" };
+        newRow( "only links" ) << " ,.;!? 123\t" << QStringList{ "L: ,.;!? 123\t" };
+
+        // every default word seperator joins two words and can start or end one
+        for( const QChar &seperator : TextAnalyser::defaultWordSeperators() )
+        {
+            const QString word{ QString{ "well" } + seperator + "known" };
+
+            newRow( QString{ "seperator U+%1" }.arg( seperator.unicode(), 4, 16, QChar{ '0' } ) )
+                    << word + " " + seperator + "tis"
+                    << QStringList{ "W:" + word, "L: ", "W:" + QString{ seperator } + "tis" };
+        }
+
+        newRow( "only seperators" ) << "-'`" << QStringList{ "W:-'`" };
+        newRow( "apostrophe" ) << "don't stop" << QStringList{ "W:don't", "L: ", "W:stop" };
+        newRow( "digits" ) << "abc123def 42" << QStringList{ "W:abc", "L:123", "W:def", "L: 42" };
+        newRow( "umlauts" ) << "Grüße aus Köln" << QStringList{ "W:Grüße", "L: ", "W:aus", "L: ", "W:Köln" };
+
+        newRow( "surrogate letter" ) << "a" + scriptA + "b c" << QStringList{ "W:a" + scriptA + "b", "L: ", "W:c" };
+        newRow( "surrogate letter first" ) << scriptA + " x" << QStringList{ "W:" + scriptA, "L: ", "W:x" };
+        newRow( "surrogate non-letter" ) << "hi" + emoji + "there" << QStringList{ "W:hi", "L:" + emoji, "W:there" };
+
+        // class changes right before, at and after the end of the 8 and 16 unit blocks
+        for( const int boundary : { 7, 8, 9, 15, 16, 17, 31, 32, 33 } )
+        {
+            newRow( QString{ "change at %1" }.arg( boundary ) )
+                    << QString{ boundary, 'a' } + " " + QString{ 40 - boundary, 'b' }
+                    << QStringList{ "W:" + QString{ boundary, 'a' }, "L: ", "W:" + QString{ 40 - boundary, 'b' } };
+        }
+
+        newRow( "changes at 16 and 32" ) << QString{ 16, 'a' } + QString{ 16, ' ' } + QString{ 16, 'b' }
+                                         << QStringList{ "W:" + QString{ 16, 'a' }, "L:" + QString{ 16, ' ' },
+                                                         "W:" + QString{ 16, 'b' } };
+
+        // the block containing the umlaut isn't pure ASCII and is classified one unit at a time
+        newRow( "non-ASCII at 15" ) << QString{ 15, 'a' } + QString{ QChar{ 0xE4 } } + " " + QString{ 20, 'b' }
+                                    << QStringList{ "W:" + QString{ 15, 'a' } + QChar{ 0xE4 }, "L: ",
+                                                    "W:" + QString{ 20, 'b' } };
+
+        newRow( "surrogate at 15" ) << QString{ 15, 'a' } + scriptA + " " + QString{ 20, 'b' }
+                                    << QStringList{ "W:" + QString{ 15, 'a' } + scriptA, "L: ",
+                                                    "W:" + QString{ 20, 'b' } };
+    }
+}
+
+void TokenizerTest::tokenise()
+{
+    QFETCH( Tokenizer::InstructionSet, instructionSet );
+    QFETCH( QString, text );
+    QFETCH( QStringList, expected );
+
+    const Tokenizer tokenizer{ TextAnalyser::defaultWordSeperators(), instructionSet };
+    QCOMPARE( tokenizer.getInstructionSet(), instructionSet );
+
+    TokenStore tokens;
+    QVERIFY( tokenizer.tokenise( text, tokens ) );
+
+    QCOMPARE( describe( tokens ), expected );
+
+    // the tokens are slices covering the whole text without gaps
+    int offset = 0;
+
+    for( int i = 0; i < tokens.size(); ++i )
+    {
+        QCOMPARE( tokens.offset( i ), offset );
+        offset += tokens.length( i );
+    }
+
+    QCOMPARE( offset, text.size() );
+}
+
+void TokenizerTest::abort()
+{
+    const Tokenizer tokenizer{ TextAnalyser::defaultWordSeperators() };
+
+    TokenStore tokens;
+    const bool finished = tokenizer.tokenise( "some words", tokens,
+                                              []( const int, const int )
+                                              {
+                                                  return false;
+                                              } );
+
+    QVERIFY( !finished );
+    QVERIFY( tokens.isEmpty() );
+}
@@ -0,0 +1,18 @@
+#ifndef TOKENIZERTEST_H
+#define TOKENIZERTEST_H
+
+#include <QObject>
+
+// Token streams of the Tokenizer, every case is run with every instruction set this machine supports
+class TokenizerTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void tokenise_data();
+    void tokenise();
+
+    void abort();
+};
+
+#endif // TOKENIZERTEST_H